@@ -0,0 +1,814 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using System.Text;
+
+namespace CompoundGen
+{
+    /// <summary>
+    /// This program compiles the compound database from its text pattern language into a compact binary image.
+    /// The image is written out twice:
+    /// * As a pair of C++/header files that embed the image in the game, which is what Sifteo builds use.
+    /// * As a raw binary file, which the standalone app memory-maps at startup so compounds can be changed without rebuilding it.
+    /// The game reads the image in place, so the layout written here must exactly match the structures in CompoundDatabase.h and ReactionNode.h.
+    /// The pattern language is documented at the top of compounds.txt.
+    /// </summary>
+    class Program
+    {
+        /// <summary>Must match COMPOUND_DATABASE_VERSION in CompoundDatabase.h</summary>
+        const int imageVersion = 6;
+        const string imageMagic = "PCDB";
+        const int headerSize = 24;
+        const int patternRecordSize = 36;
+        const int nodeRecordSize = 8;
+        const int prefixRecordSize = 4;
+
+        /// <summary>The most patterns the game can load, must match MAX_DATABASE_PATTERNS in CompoundDatabase.h (Shared prefixes are stored as pattern masks.)</summary>
+        const int maxPatterns = 32;
+
+        /// <summary>The number of spaces in one level of indentation, tabs count as one level.</summary>
+        const int indentSize = 4;
+
+        /// <summary>The number of sides on an element, which limits the number of children a node can have.</summary>
+        const int maxChildren = 4;
+
+        /// <summary>The number of distinct symbols a pattern record can require, must match MAX_PATTERN_REQUIRED_SYMBOLS in CompoundDatabase.h</summary>
+        const int maxRequiredSymbols = 4;
+
+        /// <summary>The largest count stored in a pattern's required group counts, which are packed into 4 bits each.</summary>
+        const int maxRequiredGroupCount = 7;
+
+        /// <summary>The value used for the group of nodes that don't have a group, must match REACTION_NODE_NO_GROUP in ReactionNode.h</summary>
+        const byte noGroup = 0xFF;
+
+        // These must match the enumerations of the same name in the game, the generated C++ file verifies that they do.
+        enum ReactionNodeType { ElementSymbolFilter, ElementSymbol, ElementGroupFilter, ElementGroup, EitherOr, NoOp };
+        enum BondType { None, Ionic, Covalent };
+        static readonly string[] groups = { "ALKALI", "ALKALIEARTH", "HALOGEN", "NOBLE", "HYDROGEN", "NONMETAL", "METALOID" };
+
+        /// <summary>
+        /// The symbols of the periodic table, indexed by atomic number.
+        /// Symbols are interned to atomic numbers in the image so the game can match elements without comparing strings.
+        /// </summary>
+        static readonly string[] atomicSymbols =
+        {
+            "",
+            "H", "He",
+            "Li", "Be", "B", "C", "N", "O", "F", "Ne",
+            "Na", "Mg", "Al", "Si", "P", "S", "Cl", "Ar",
+            "K", "Ca", "Sc", "Ti", "V", "Cr", "Mn", "Fe", "Co", "Ni", "Cu", "Zn", "Ga", "Ge", "As", "Se", "Br", "Kr",
+            "Rb", "Sr", "Y", "Zr", "Nb", "Mo", "Tc", "Ru", "Rh", "Pd", "Ag", "Cd", "In", "Sn", "Sb", "Te", "I", "Xe",
+            "Cs", "Ba", "La", "Ce", "Pr", "Nd", "Pm", "Sm", "Eu", "Gd", "Tb", "Dy", "Ho", "Er", "Tm", "Yb", "Lu",
+            "Hf", "Ta", "W", "Re", "Os", "Ir", "Pt", "Au", "Hg", "Tl", "Pb", "Bi", "Po", "At", "Rn",
+            "Fr", "Ra", "Ac", "Th", "Pa", "U", "Np", "Pu", "Am", "Cm", "Bk", "Cf", "Es", "Fm", "Md", "No", "Lr",
+            "Rf", "Db", "Sg", "Bh", "Hs", "Mt", "Ds", "Rg", "Cn", "Nh", "Fl", "Mc", "Lv", "Ts", "Og"
+        };
+
+        class Node
+        {
+            public int Line;
+            public ReactionNodeType Type;
+            public int Depth;
+            public BondType BondType = BondType.None;
+            public int BondLeftData;
+            public int BondRightData;
+            public byte Group = noGroup;
+            /// <summary>The atomic number of the element used by symbol nodes, 0 otherwise.</summary>
+            public byte AtomicNumber;
+        }
+
+        class Pattern
+        {
+            public int Line;
+            public string Name;
+            public List<Node> Nodes = new List<Node>();
+        }
+
+        /// <summary>
+        /// The elements a reaction must contain for a pattern (or part of a pattern) to have any chance of matching.
+        /// Every element a pattern matches is distinct, so these are lower bounds the game can check before searching.
+        /// </summary>
+        class Requirements
+        {
+            public int ElementCount;
+            public int[] GroupCounts = new int[groups.Length];
+            /// <summary>The number of elements needed for each atomic number</summary>
+            public SortedDictionary<int, int> AtomCounts = new SortedDictionary<int, int>();
+
+            public void Add(Requirements other)
+            {
+                ElementCount += other.ElementCount;
+
+                for (int i = 0; i < GroupCounts.Length; i++)
+                { GroupCounts[i] += other.GroupCounts[i]; }
+
+                foreach (KeyValuePair<int, int> atom in other.AtomCounts)
+                {
+                    int count;
+                    AtomCounts.TryGetValue(atom.Key, out count);
+                    AtomCounts[atom.Key] = count + atom.Value;
+                }
+            }
+
+            /// <summary>Returns the requirements met by either of the given requirements, used for the branches of an 'either'.</summary>
+            public static Requirements Min(Requirements a, Requirements b)
+            {
+                Requirements ret = new Requirements();
+                ret.ElementCount = Math.Min(a.ElementCount, b.ElementCount);
+
+                for (int i = 0; i < ret.GroupCounts.Length; i++)
+                { ret.GroupCounts[i] = Math.Min(a.GroupCounts[i], b.GroupCounts[i]); }
+
+                foreach (KeyValuePair<int, int> atom in a.AtomCounts)
+                {
+                    int count;
+                    if (b.AtomCounts.TryGetValue(atom.Key, out count))
+                    { ret.AtomCounts[atom.Key] = Math.Min(atom.Value, count); }
+                }
+
+                return ret;
+            }
+        }
+
+        /// <summary>Thrown when the input file contains an error.</summary>
+        class CompileException : Exception
+        {
+            public int Line;
+
+            public CompileException(int line, string format, params object[] args)
+                : base(String.Format(format, args))
+            {
+                Line = line;
+            }
+        }
+
+        /// <summary>
+        /// Parses an element from a node, either a symbol (Cl) or a group (@HALOGEN).
+        /// </summary>
+        /// <returns>True if the element is a group, false if it is a symbol.</returns>
+        static bool ParseElement(int line, string element, Node node)
+        {
+            if (element.StartsWith("@"))
+            {
+                int group = Array.IndexOf(groups, element.Substring(1));
+                if (group < 0)
+                { throw new CompileException(line, "'{0}' is not a valid group, expected one of @{1}.", element, String.Join(", @", groups)); }
+
+                node.Group = (byte)group;
+                return true;
+            }
+
+            int atomicNumber = Array.IndexOf(atomicSymbols, element);
+            if (atomicNumber < 1)
+            { throw new CompileException(line, "'{0}' is not a valid element symbol.", element); }
+
+            node.AtomicNumber = (byte)atomicNumber;
+            return false;
+        }
+
+        static int ParseBondOrder(int line, string order)
+        {
+            int ret;
+            if (!Int32.TryParse(order, out ret) || ret < 1 || ret > Byte.MaxValue)
+            { throw new CompileException(line, "'{0}' is not a valid bond order.", order); }
+            return ret;
+        }
+
+        /// <summary>
+        /// Parses the bond at the end of a node, if it has one.
+        /// </summary>
+        static void ParseBond(int line, string[] tokens, int start, Node node)
+        {
+            if (start >= tokens.Length)
+            { return; }
+
+            if (tokens[start] == "ionic" && tokens.Length == start + 1)
+            {
+                node.BondType = BondType.Ionic;
+            }
+            else if (tokens[start] == "covalent" && (tokens.Length == start + 2 || tokens.Length == start + 3))
+            {
+                node.BondType = BondType.Covalent;
+                node.BondLeftData = ParseBondOrder(line, tokens[start + 1]);
+                node.BondRightData = tokens.Length == start + 3 ? ParseBondOrder(line, tokens[start + 2]) : node.BondLeftData;
+            }
+            else
+            {
+                throw new CompileException(line, "Invalid bond '{0}', expected 'ionic', 'covalent <order>', or 'covalent <left order> <right order>'.", String.Join(" ", tokens, start, tokens.Length - start));
+            }
+        }
+
+        static Node ParseNode(int line, int depth, string[] tokens)
+        {
+            Node node = new Node();
+            node.Line = line;
+            node.Depth = depth;
+
+            switch (tokens[0])
+            {
+                case "either":
+                case "otherwise":
+                    if (tokens.Length != 1)
+                    { throw new CompileException(line, "'{0}' doesn't take any arguments.", tokens[0]); }
+                    node.Type = tokens[0] == "either" ? ReactionNodeType.EitherOr : ReactionNodeType.NoOp;
+                    break;
+                case "is":
+                    if (tokens.Length != 2)
+                    { throw new CompileException(line, "Expected 'is <element>'."); }
+                    node.Type = ParseElement(line, tokens[1], node) ? ReactionNodeType.ElementGroupFilter : ReactionNodeType.ElementSymbolFilter;
+                    break;
+                default:
+                    node.Type = ParseElement(line, tokens[0], node) ? ReactionNodeType.ElementGroup : ReactionNodeType.ElementSymbol;
+                    ParseBond(line, tokens, 1, node);
+                    break;
+            }
+
+            return node;
+        }
+
+        /// <summary>
+        /// Parses the compound database from the given input file.
+        /// </summary>
+        static List<Pattern> Parse(string inputFile)
+        {
+            List<Pattern> patterns = new List<Pattern>();
+            Pattern pattern = null;
+            int lineNumber = 0;
+
+            foreach (string rawLine in File.ReadAllLines(inputFile))
+            {
+                lineNumber++;
+
+                // Strip comments and skip blank lines:
+                string line = rawLine;
+                int commentStart = line.IndexOf('#');
+                if (commentStart >= 0)
+                { line = line.Substring(0, commentStart); }
+
+                line = line.TrimEnd();
+                if (line.Length == 0)
+                { continue; }
+
+                // Measure the indentation:
+                int indent = 0;
+                int i;
+                for (i = 0; i < line.Length && (line[i] == ' ' || line[i] == '\t'); i++)
+                { indent += line[i] == '\t' ? indentSize : 1; }
+
+                if ((indent % indentSize) != 0)
+                { throw new CompileException(lineNumber, "Indentation must be a multiple of {0} spaces.", indentSize); }
+
+                int depth = indent / indentSize;
+                string[] tokens = line.Substring(i).Split(new char[] { ' ', '\t' }, StringSplitOptions.RemoveEmptyEntries);
+
+                // Start new compounds:
+                if (tokens[0] == "compound")
+                {
+                    if (depth != 0 || tokens.Length != 2)
+                    { throw new CompileException(lineNumber, "Expected 'compound <Name>' without any indentation."); }
+
+                    foreach (Pattern other in patterns)
+                    {
+                        if (other.Name == tokens[1])
+                        { throw new CompileException(lineNumber, "Compound '{0}' was already defined on line {1}.", tokens[1], other.Line); }
+                    }
+
+                    pattern = new Pattern();
+                    pattern.Line = lineNumber;
+                    pattern.Name = tokens[1];
+                    patterns.Add(pattern);
+                    continue;
+                }
+
+                // Anything else is a node of the current compound:
+                if (pattern == null)
+                { throw new CompileException(lineNumber, "Expected 'compound <Name>' before the first node."); }
+
+                if (pattern.Nodes.Count == 0 ? depth != 0 : depth > pattern.Nodes[pattern.Nodes.Count - 1].Depth + 1)
+                { throw new CompileException(lineNumber, "Node is indented too far."); }
+
+                if (pattern.Nodes.Count > 0 && depth == 0)
+                { throw new CompileException(lineNumber, "Compound '{0}' already has a root node, only one is allowed.", pattern.Name); }
+
+                pattern.Nodes.Add(ParseNode(lineNumber, depth, tokens));
+            }
+
+            return patterns;
+        }
+
+        /// <summary>
+        /// Checks the structure of a parsed pattern.
+        /// </summary>
+        /// <returns>The largest number of children any node in the pattern has.</returns>
+        static int Validate(Pattern pattern)
+        {
+            if (pattern.Nodes.Count == 0)
+            { throw new CompileException(pattern.Line, "Compound '{0}' is empty.", pattern.Name); }
+
+            int ret = 0;
+            for (int i = 0; i < pattern.Nodes.Count; i++)
+            {
+                Node node = pattern.Nodes[i];
+                Node parent = null;
+                int children = 0;
+
+                for (int j = i - 1; j >= 0 && parent == null; j--)
+                {
+                    if (pattern.Nodes[j].Depth == node.Depth - 1)
+                    { parent = pattern.Nodes[j]; }
+                }
+
+                for (int j = i + 1; j < pattern.Nodes.Count && pattern.Nodes[j].Depth > node.Depth; j++)
+                {
+                    if (pattern.Nodes[j].Depth == node.Depth + 1)
+                    { children++; }
+                }
+
+                if (children > maxChildren)
+                { throw new CompileException(node.Line, "Node has {0} children, but an element only has {1} sides.", children, maxChildren); }
+
+                if (node.Type == ReactionNodeType.EitherOr && children == 0)
+                { throw new CompileException(node.Line, "'either' must have at least one branch."); }
+
+                if (node.Type == ReactionNodeType.NoOp && (parent == null || parent.Type != ReactionNodeType.EitherOr))
+                { throw new CompileException(node.Line, "'otherwise' can only be used as a branch of an 'either'."); }
+
+                ret = Math.Max(ret, children);
+            }
+
+            return ret;
+        }
+
+        /// <summary>
+        /// Gets the requirements of the node at the given index of a pattern, including all of its children.
+        /// </summary>
+        static Requirements GetRequirements(Pattern pattern, int index)
+        {
+            Node node = pattern.Nodes[index];
+            Requirements ret = new Requirements();
+            Requirements branches = null;
+
+            for (int i = index + 1; i < pattern.Nodes.Count && pattern.Nodes[i].Depth > node.Depth; i++)
+            {
+                if (pattern.Nodes[i].Depth != node.Depth + 1)
+                { continue; }
+
+                Requirements child = GetRequirements(pattern, i);
+
+                // Only one branch of an 'either' has to match, so it only requires what every branch requires.
+                if (node.Type == ReactionNodeType.EitherOr)
+                { branches = branches == null ? child : Requirements.Min(branches, child); }
+                else
+                { ret.Add(child); }
+            }
+
+            if (branches != null)
+            { ret.Add(branches); }
+
+            // The root matches the element the pattern is tried with, and nodes that bond to a neighbor match a new element.
+            // Filters below the root only narrow down an element that was already counted.
+            if (index == 0 || node.Type == ReactionNodeType.ElementSymbol || node.Type == ReactionNodeType.ElementGroup)
+            {
+                ret.ElementCount++;
+
+                if (node.Type == ReactionNodeType.ElementSymbol || node.Type == ReactionNodeType.ElementSymbolFilter)
+                {
+                    int count;
+                    ret.AtomCounts.TryGetValue(node.AtomicNumber, out count);
+                    ret.AtomCounts[node.AtomicNumber] = count + 1;
+                }
+                else if (node.Type == ReactionNodeType.ElementGroup || node.Type == ReactionNodeType.ElementGroupFilter)
+                {
+                    ret.GroupCounts[node.Group]++;
+                }
+            }
+
+            return ret;
+        }
+
+        /// <summary>
+        /// Gets what the node at the given index of a pattern requires of the neighbors of its output. Each node below it that bonds to a neighbor
+        /// needs a different one, and nodes that pass their input through look at the neighbors of the same element.
+        /// </summary>
+        static Requirements GetNeighborRequirements(Pattern pattern, int index)
+        {
+            Node node = pattern.Nodes[index];
+            Requirements ret = new Requirements();
+            Requirements branches = null;
+
+            for (int i = index + 1; i < pattern.Nodes.Count && pattern.Nodes[i].Depth > node.Depth; i++)
+            {
+                if (pattern.Nodes[i].Depth != node.Depth + 1)
+                { continue; }
+
+                Node childNode = pattern.Nodes[i];
+                Requirements child;
+                if (childNode.Type == ReactionNodeType.ElementSymbol || childNode.Type == ReactionNodeType.ElementGroup)
+                {
+                    child = new Requirements();
+                    child.ElementCount = 1;
+
+                    if (childNode.Type == ReactionNodeType.ElementSymbol)
+                    { child.AtomCounts[childNode.AtomicNumber] = 1; }
+                    else
+                    { child.GroupCounts[childNode.Group] = 1; }
+                }
+                else
+                { child = GetNeighborRequirements(pattern, i); }
+
+                if (node.Type == ReactionNodeType.EitherOr)
+                { branches = branches == null ? child : Requirements.Min(branches, child); }
+                else
+                { ret.Add(child); }
+            }
+
+            if (branches != null)
+            { ret.Add(branches); }
+
+            return ret;
+        }
+
+        /// <summary>
+        /// Gets what the root element of a pattern requires of its neighbors. Only roots that pass their input through have requirements, since the
+        /// output of any other root is a neighbor of the root element rather than the root element itself.
+        /// </summary>
+        static Requirements GetRootNeighborRequirements(Pattern pattern)
+        {
+            switch (pattern.Nodes[0].Type)
+            {
+                case ReactionNodeType.ElementSymbol:
+                case ReactionNodeType.ElementGroup:
+                    return new Requirements();
+                default:
+                    return GetNeighborRequirements(pattern, 0);
+            }
+        }
+
+        /// <summary>
+        /// Writes requirements in the layout of the required or root neighbor fields of a CompoundDatabasePattern.
+        /// padding is the number of reserved bytes between the counts and the group counts, which keeps the group counts word-aligned.
+        /// </summary>
+        static void WriteRequirements(BinaryWriter writer, Requirements requirements, int padding)
+        {
+            // If a pattern needs more distinct symbols than fit in the record, keep the ones it needs the most of. (Dropping requirements is always safe.)
+            List<KeyValuePair<int, int>> atoms = new List<KeyValuePair<int, int>>(requirements.AtomCounts);
+            atoms.Sort((a, b) => a.Value != b.Value ? b.Value.CompareTo(a.Value) : a.Key.CompareTo(b.Key));
+            if (atoms.Count > maxRequiredSymbols)
+            { atoms.RemoveRange(maxRequiredSymbols, atoms.Count - maxRequiredSymbols); }
+
+            uint groupCounts = 0;
+            for (int i = 0; i < requirements.GroupCounts.Length; i++)
+            { groupCounts |= (uint)Math.Min(requirements.GroupCounts[i], maxRequiredGroupCount) << (i * 4); }
+
+            writer.Write((byte)Math.Min(requirements.ElementCount, Byte.MaxValue));
+            writer.Write((byte)atoms.Count);
+            for (int i = 0; i < padding; i++)
+            { writer.Write((byte)0); }
+            writer.Write(groupCounts);
+            for (int i = 0; i < maxRequiredSymbols; i++)
+            { writer.Write((byte)(i < atoms.Count ? atoms[i].Key : 0)); }
+            for (int i = 0; i < maxRequiredSymbols; i++)
+            { writer.Write((byte)(i < atoms.Count ? Math.Min(atoms[i].Value, Byte.MaxValue) : 0)); }
+        }
+
+        /// <summary>
+        /// Returns true if the given nodes would make the search take the same steps, which is the case when they only differ in the bonds they form.
+        /// (Bonds are applied after the search succeeds, and every node marks its elements as in use regardless of its bond.)
+        /// </summary>
+        static bool SearchesAlike(Node a, Node b)
+        {
+            return a.Type == b.Type && a.Depth == b.Depth && a.Group == b.Group && a.AtomicNumber == b.AtomicNumber;
+        }
+
+        /// <summary>
+        /// Returns the index just past the subtree of the node at the given index of a pattern.
+        /// </summary>
+        static int GetSubtreeEnd(Pattern pattern, int index)
+        {
+            int ret = index + 1;
+            while (ret < pattern.Nodes.Count && pattern.Nodes[ret].Depth > pattern.Nodes[index].Depth)
+            { ret++; }
+            return ret;
+        }
+
+        /// <summary>
+        /// Returns the index of the twin of the node at the given index of a pattern, which is the node itself if it doesn't have one.
+        /// Siblings whose subtrees the search would treat exactly the same are interchangeable, and the twin of a node is the node in the same place
+        /// under the first of its interchangeable siblings. (Or of its parent's or any other ancestor's.) The game lets twins share what it learns
+        /// about which elements their subtrees fail with.
+        /// </summary>
+        static int GetTwin(Pattern pattern, int index)
+        {
+            int end = GetSubtreeEnd(pattern, index);
+            int depth = pattern.Nodes[index].Depth;
+
+            // Walk back through the earlier siblings to the parent, looking for the first one that is interchangeable with this node:
+            int ret = index;
+            int parent = index - 1;
+            for (; parent >= 0 && pattern.Nodes[parent].Depth >= depth; parent--)
+            {
+                if (pattern.Nodes[parent].Depth != depth || GetSubtreeEnd(pattern, parent) - parent != end - index)
+                { continue; }
+
+                bool same = true;
+                for (int j = 0; j < end - index && same; j++)
+                { same = SearchesAlike(pattern.Nodes[parent + j], pattern.Nodes[index + j]); }
+
+                if (same)
+                { ret = parent; }
+            }
+
+            // If the parent has a twin, so does every node under it:
+            if (parent >= 0)
+            {
+                int parentTwin = GetTwin(pattern, parent);
+                if (parentTwin != parent)
+                { ret = GetTwin(pattern, ret - (parent - parentTwin)); }
+            }
+
+            return ret;
+        }
+
+        /// <summary>
+        /// Returns true if the first length nodes of the given pattern are a prefix which can only fail to match if the whole pattern fails too.
+        /// This is true unless the prefix leaves out a branch of an 'either', since the left out branch could succeed where the others failed.
+        /// </summary>
+        static bool IsSharablePrefix(Pattern pattern, int length)
+        {
+            for (int i = 0; i < length; i++)
+            {
+                if (pattern.Nodes[i].Type != ReactionNodeType.EitherOr)
+                { continue; }
+
+                for (int j = i + 1; j < pattern.Nodes.Count && pattern.Nodes[j].Depth > pattern.Nodes[i].Depth; j++)
+                {
+                    if (pattern.Nodes[j].Depth == pattern.Nodes[i].Depth + 1 && j >= length)
+                    { return false; }
+                }
+            }
+
+            return true;
+        }
+
+        /// <summary>
+        /// Merges the patterns into a trie of the prefixes they share, and returns the accepting patterns of every trie node.
+        /// There's one trie node for each node of each pattern, made up of the pattern's nodes up to and including that node. The mask of that trie
+        /// node has a bit set for every pattern which starts with the same nodes (ignoring bonds) and can only match when they do.
+        /// When a pattern fails without getting past a node, the game uses these masks to skip every other pattern that would fail the same way.
+        /// </summary>
+        static List<uint> GetSharedPrefixMasks(List<Pattern> patterns)
+        {
+            List<uint> ret = new List<uint>();
+
+            foreach (Pattern pattern in patterns)
+            {
+                for (int length = 1; length <= pattern.Nodes.Count; length++)
+                {
+                    uint mask = 0;
+                    for (int p = 0; p < patterns.Count; p++)
+                    {
+                        Pattern other = patterns[p];
+                        if (other.Nodes.Count < length || !IsSharablePrefix(other, length))
+                        { continue; }
+
+                        bool shared = true;
+                        for (int i = 0; i < length && shared; i++)
+                        { shared = SearchesAlike(pattern.Nodes[i], other.Nodes[i]); }
+
+                        if (shared)
+                        { mask |= 1u << p; }
+                    }
+
+                    ret.Add(mask);
+                }
+            }
+
+            return ret;
+        }
+
+        /// <summary>
+        /// Builds the binary image of the compound database, see CompoundDatabase.h for the layout.
+        /// </summary>
+        static byte[] BuildImage(List<Pattern> patterns, int maxDepth, int nodeCount)
+        {
+            using (MemoryStream stream = new MemoryStream())
+            using (BinaryWriter writer = new BinaryWriter(stream, Encoding.ASCII))
+            {
+                int patternsOffset = headerSize;
+                int nodesOffset = patternsOffset + patterns.Count * patternRecordSize;
+                nodesOffset = (nodesOffset + 3) & ~3; // Keep the node table word-aligned
+                int prefixesOffset = nodesOffset + nodeCount * nodeRecordSize;
+                int namesOffset = prefixesOffset + nodeCount * prefixRecordSize;
+
+                // Header (size is filled in at the end)
+                writer.Write(Encoding.ASCII.GetBytes(imageMagic));
+                writer.Write((byte)imageVersion);
+                writer.Write((byte)maxDepth);
+                writer.Write((ushort)patterns.Count);
+                writer.Write((ushort)nodeCount);
+                writer.Write((ushort)patternsOffset);
+                writer.Write((ushort)nodesOffset);
+                writer.Write((ushort)prefixesOffset);
+                writer.Write((ushort)namesOffset);
+                writer.Write((ushort)0); // Reserved
+                writer.Write((uint)0);
+
+                // Patterns
+                int firstNode = 0;
+                int nameOffset = 0;
+                foreach (Pattern pattern in patterns)
+                {
+                    writer.Write((ushort)firstNode);
+                    writer.Write((ushort)pattern.Nodes.Count);
+                    writer.Write((ushort)nameOffset);
+                    WriteRequirements(writer, GetRequirements(pattern, 0), 0);
+                    WriteRequirements(writer, GetRootNeighborRequirements(pattern), 2);
+                    firstNode += pattern.Nodes.Count;
+                    nameOffset += pattern.Name.Length + 1;
+                }
+
+                while (stream.Position < nodesOffset)
+                { writer.Write((byte)0); }
+
+                // Nodes
+                foreach (Pattern pattern in patterns)
+                {
+                    for (int i = 0; i < pattern.Nodes.Count; i++)
+                    {
+                        Node node = pattern.Nodes[i];
+                        writer.Write((byte)node.Type);
+                        writer.Write((byte)node.Depth);
+                        writer.Write((byte)node.BondType);
+                        writer.Write((byte)node.BondLeftData);
+                        writer.Write((byte)node.BondRightData);
+                        writer.Write(node.Group);
+                        writer.Write(node.AtomicNumber);
+                        int twinOffset = i - GetTwin(pattern, i);
+                        writer.Write((byte)(twinOffset <= Byte.MaxValue ? twinOffset : 0));
+                    }
+                }
+
+                // Shared prefixes
+                foreach (uint mask in GetSharedPrefixMasks(patterns))
+                { writer.Write(mask); }
+
+                // Names
+                foreach (Pattern pattern in patterns)
+                {
+                    writer.Write(Encoding.ASCII.GetBytes(pattern.Name));
+                    writer.Write((byte)0);
+                }
+
+                while ((stream.Position % 4) != 0)
+                { writer.Write((byte)0); }
+
+                // Fill in the size
+                uint size = (uint)stream.Position;
+                stream.Position = headerSize - sizeof(uint);
+                writer.Write(size);
+                writer.Flush();
+
+                if (nameOffset > UInt16.MaxValue || namesOffset > UInt16.MaxValue || nodeCount > UInt16.MaxValue)
+                { throw new CompileException(0, "The compound database is too large for the image format."); }
+
+                return stream.ToArray();
+            }
+        }
+
+        /// <summary>
+        /// Writes a header comment to the specified output file.
+        /// </summary>
+        /// <param name="f">The file stream to output the header line to</param>
+        /// <param name="outputFile">The name of the file this header will go into</param>
+        /// <param name="inputFile">The name of the file used to generate this file</param>
+        static void WriteHeader(StreamWriter f, string outputFile, string inputFile)
+        {
+            f.WriteLine("// {0} - automatically generated by {1} using {2}, do not edit this file directly!", outputFile, Assembly.GetExecutingAssembly().GetName().Name, inputFile);
+        }
+
+        /// <summary>
+        /// Entry point for the compound database compiler.
+        /// </summary>
+        /// <param name="args">Command line arguments for this program. Currently only one is supported, the compound database source file.</param>
+        /// <returns>An exit code for the program.</returns>
+        static int Main(string[] args)
+        {
+            Console.WriteLine("Compound Database Compiler for Periodic");
+
+            // Verify / parse arguments
+            if (args.Length != 1)
+            {
+                Console.WriteLine("Usage: CompoundGen compounds.txt");
+                Console.WriteLine();
+                return 1;
+            }
+
+            string inputFile = args[0];
+            string databaseName = Path.GetFileNameWithoutExtension(inputFile);
+            string DATABASENAME = databaseName.ToUpperInvariant();
+            string outputFileCpp = Path.Combine(Path.GetDirectoryName(inputFile), databaseName + ".gen.cpp");
+            string outputFileHeader = Path.Combine(Path.GetDirectoryName(inputFile), databaseName + ".gen.h");
+            string outputFileBinary = Path.Combine(Path.GetDirectoryName(inputFile), databaseName + ".bin");
+
+            // Compile the database:
+            List<Pattern> patterns;
+            int maxDepth = 0;
+            int maxChildCount = 0;
+            int nodeCount = 0;
+            byte[] image;
+
+            try
+            {
+                patterns = Parse(inputFile);
+
+                if (patterns.Count == 0)
+                { throw new CompileException(0, "The compound database is empty."); }
+
+                if (patterns.Count > maxPatterns)
+                { throw new CompileException(patterns[maxPatterns].Line, "The compound database has more than {0} compounds.", maxPatterns); }
+
+                foreach (Pattern pattern in patterns)
+                {
+                    maxChildCount = Math.Max(maxChildCount, Validate(pattern));
+                    nodeCount += pattern.Nodes.Count;
+
+                    foreach (Node node in pattern.Nodes)
+                    { maxDepth = Math.Max(maxDepth, node.Depth); }
+                }
+
+                image = BuildImage(patterns, maxDepth, nodeCount);
+            }
+            catch (CompileException ex)
+            {
+                // This format is understood by Visual Studio's error list.
+                Console.WriteLine("{0}({1}): error: {2}", inputFile, ex.Line, ex.Message);
+                return 1;
+            }
+
+            Console.WriteLine("Compiled {0} compounds with {1} nodes into {2} bytes.", patterns.Count, nodeCount, image.Length);
+
+            // Output the binary image:
+            File.WriteAllBytes(outputFileBinary, image);
+
+            // Output C++ file:
+            using (StreamWriter f = new StreamWriter(outputFileCpp))
+            {
+                WriteHeader(f, outputFileCpp, inputFile);
+                f.WriteLine();
+                f.WriteLine("#include \"{0}\"", Path.GetFileName(outputFileHeader));
+                f.WriteLine("#include \"periodic.h\"");
+                f.WriteLine("#include \"CompoundDatabase.h\"");
+                f.WriteLine();
+
+                // The image stores these enumerations as raw numbers, so make sure the game agrees with this tool about what they are:
+                f.WriteLine("// {0} and the game must agree on these values:", Assembly.GetExecutingAssembly().GetName().Name);
+                foreach (ReactionNodeType type in Enum.GetValues(typeof(ReactionNodeType)))
+                { f.WriteLine("CompilerAssert(ReactionNodeType_{0} == {1});", type, (int)type); }
+                foreach (BondType type in Enum.GetValues(typeof(BondType)))
+                { f.WriteLine("CompilerAssert(BondType_{0} == {1});", type, (int)type); }
+                for (int i = 0; i < groups.Length; i++)
+                { f.WriteLine("CompilerAssert({0} == {1});", groups[i], i); }
+                f.WriteLine("CompilerAssert(GROUP_COUNT == {0});", groups.Length);
+                f.WriteLine("CompilerAssert(REACTION_NODE_NO_GROUP == 0x{0:X2});", noGroup);
+                f.WriteLine("CompilerAssert(MAX_PATTERN_REQUIRED_SYMBOLS == {0});", maxRequiredSymbols);
+                f.WriteLine();
+
+                f.WriteLine("alignas(4) const unsigned char {0}[{1}_SIZE] =", databaseName, DATABASENAME);
+                f.WriteLine("{");
+                for (int i = 0; i < image.Length; i += 16)
+                {
+                    f.Write("   ");
+                    for (int j = i; j < i + 16 && j < image.Length; j++)
+                    { f.Write(" 0x{0:X2},", image[j]); }
+                    f.WriteLine();
+                }
+                f.WriteLine("};");
+                f.WriteLine();
+            }
+
+            // Output the header file:
+            using (StreamWriter f = new StreamWriter(outputFileHeader))
+            {
+                WriteHeader(f, outputFileHeader, inputFile);
+                string headerGuard = Path.GetFileName(outputFileHeader).ToUpperInvariant().Replace('.', '_');
+                f.WriteLine("#ifndef __{0}__", headerGuard);
+                f.WriteLine("#define __{0}__", headerGuard);
+                f.WriteLine();
+                f.WriteLine("#define {0}_VERSION {1}", DATABASENAME, imageVersion);
+                f.WriteLine("#define {0}_PATTERN_COUNT {1}", DATABASENAME, patterns.Count);
+                f.WriteLine("#define {0}_NODE_COUNT {1}", DATABASENAME, nodeCount);
+                f.WriteLine("#define {0}_MAX_DEPTH {1}", DATABASENAME, maxDepth);
+                f.WriteLine("#define {0}_MAX_CHILDREN {1}", DATABASENAME, maxChildCount);
+                f.WriteLine();
+                f.WriteLine("#define {0}_SIZE {1}", DATABASENAME, image.Length);
+                f.WriteLine("extern const unsigned char {0}[{1}_SIZE];", databaseName, DATABASENAME);
+                f.WriteLine();
+                f.WriteLine("#endif");
+                f.WriteLine();
+            }
+
+            return 0;
+        }
+    }
+}
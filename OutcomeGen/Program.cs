@@ -0,0 +1,224 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Threading.Tasks;
+
+namespace OutcomeGen
+{
+    /// <summary>
+    /// This program generates the outcome table the standalone app uses to answer small reactions without searching the compound database.
+    /// It enumerates every layout of up to maxElementCount cubes and every assignment of elements to them, and runs the game's own reaction search
+    /// (from periodic.dll) on each of them. The layouts that form compounds are written out sorted by their key so the game can binary search them.
+    /// The game reads the table in place, so the layout written here must exactly match the structures in OutcomeTable.h.
+    /// </summary>
+    class Program
+    {
+        /// <summary>Must match OUTCOME_TABLE_VERSION in OutcomeTable.h</summary>
+        const int imageVersion = 1;
+        const string imageMagic = "POTB";
+        const int headerSize = 16;
+
+        /// <summary>The most elements a table can cover, must match MAX_OUTCOME_TABLE_ELEMENTS in OutcomeTable.h</summary>
+        const int maxElementCount = 3;
+        /// <summary>The number of sides on an element, in the order of BondSide.</summary>
+        const int sideCount = 4;
+        const int keyBytesPerElement = 1 + sideCount;
+        const int keySize = maxElementCount * keyBytesPerElement;
+        /// <summary>The size of an OutcomeTableEntry, which starts with its key followed by its compound count.</summary>
+        const int entrySize = 44;
+        /// <summary>Marks a side without a neighbor and pads keys with fewer elements, must match REACTION_KEY_NO_NEIGHBOR in ReactionOutcome.h</summary>
+        const byte noNeighbor = 0xFF;
+
+        /// <summary>The offset to the cube on each side of a cube, in the order of BondSide.</summary>
+        static readonly int[] sideX = { 0, -1, 0, 1 };
+        static readonly int[] sideY = { -1, 0, 1, 0 };
+
+        private const string periodicDll = "periodic.dll";
+
+        [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        private static extern bool LoadCompoundDatabase([MarshalAs(UnmanagedType.LPStr)] string path);
+
+        [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
+        private static extern uint GetCompoundDatabaseHash();
+
+        [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int GetRawElementCount();
+
+        [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
+        private static extern int GetMaxConcurrentOutcomes();
+
+        [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        private static extern bool BuildOutcomeTableEntry(byte[] key, byte[] entryOut);
+
+        /// <summary>
+        /// Finds every layout of the given number of cubes, as the key of each cube's neighbors with the elements left out.
+        /// The first cube is always the root of the reaction and every other cube joins the reaction through a cube before it, so every order the
+        /// cubes could join a reaction in is a separate layout.
+        /// </summary>
+        static List<byte[]> FindLayouts(int cubeCount)
+        {
+            List<byte[]> layouts = new List<byte[]>();
+            int[] x = new int[cubeCount];
+            int[] y = new int[cubeCount];
+            FindLayouts(layouts, x, y, 1);
+            return layouts;
+        }
+
+        static void FindLayouts(List<byte[]> layouts, int[] x, int[] y, int placed)
+        {
+            int cubeCount = x.Length;
+            if (placed == cubeCount)
+            {
+                byte[] layout = new byte[keySize];
+                for (int i = 0; i < keySize; i++)
+                { layout[i] = noNeighbor; }
+
+                for (int i = 0; i < cubeCount; i++)
+                {
+                    layout[i * keyBytesPerElement] = 0; // Filled in with the element later
+                    for (int side = 0; side < sideCount; side++)
+                    { layout[i * keyBytesPerElement + 1 + side] = (byte)FindCube(x, y, cubeCount, x[i] + sideX[side], y[i] + sideY[side]); }
+                }
+
+                layouts.Add(layout);
+                return;
+            }
+
+            // Try every empty spot next to the cubes placed so far. A spot can be next to more than one of them, so remember which were tried.
+            HashSet<Tuple<int, int>> tried = new HashSet<Tuple<int, int>>();
+            for (int i = 0; i < placed; i++)
+            {
+                for (int side = 0; side < sideCount; side++)
+                {
+                    int newX = x[i] + sideX[side];
+                    int newY = y[i] + sideY[side];
+                    if (FindCube(x, y, placed, newX, newY) != noNeighbor || !tried.Add(Tuple.Create(newX, newY)))
+                    { continue; }
+
+                    x[placed] = newX;
+                    y[placed] = newY;
+                    FindLayouts(layouts, x, y, placed + 1);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Returns the index of the cube at the given position among the first count cubes, or noNeighbor if there isn't one.
+        /// </summary>
+        static int FindCube(int[] x, int[] y, int count, int findX, int findY)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                if (x[i] == findX && y[i] == findY)
+                { return i; }
+            }
+
+            return noNeighbor;
+        }
+
+        static int CompareKeys(byte[] a, byte[] b)
+        {
+            for (int i = 0; i < keySize; i++)
+            {
+                if (a[i] != b[i])
+                { return a[i].CompareTo(b[i]); }
+            }
+
+            return 0;
+        }
+
+        /// <summary>
+        /// Entry point for the outcome table generator.
+        /// </summary>
+        /// <param name="args">Command line arguments for this program: The compound database image, followed by the output file and the number of elements to cover.</param>
+        /// <returns>An exit code for the program.</returns>
+        static int Main(string[] args)
+        {
+            Console.WriteLine("Outcome Table Generator for Periodic");
+
+            // Verify / parse arguments
+            int elementCount = maxElementCount;
+            if (args.Length < 1 || args.Length > 3 || (args.Length == 3 && (!Int32.TryParse(args[2], out elementCount) || elementCount < 2 || elementCount > maxElementCount)))
+            {
+                Console.WriteLine("Usage: OutcomeGen compounds.bin [outcomes.bin] [max elements (2-{0})]", maxElementCount);
+                Console.WriteLine();
+                return 1;
+            }
+
+            string inputFile = args[0];
+            string outputFile = args.Length > 1 ? args[1] : "outcomes.bin";
+
+            if (!LoadCompoundDatabase(inputFile))
+            {
+                Console.WriteLine("{0}: error: Could not load the compound database.", inputFile);
+                return 1;
+            }
+
+            int rawElementCount = GetRawElementCount();
+            ParallelOptions parallelOptions = new ParallelOptions();
+            parallelOptions.MaxDegreeOfParallelism = Math.Min(Environment.ProcessorCount, GetMaxConcurrentOutcomes());
+
+            // Run the reaction search on every layout:
+            List<byte[]> entries = new List<byte[]>();
+            for (int cubeCount = 2; cubeCount <= elementCount; cubeCount++)
+            {
+                List<byte[]> layouts = FindLayouts(cubeCount);
+                int assignmentCount = (int)Math.Pow(rawElementCount, cubeCount);
+                byte[][] results = new byte[layouts.Count * assignmentCount][];
+
+                Parallel.For(0, results.Length, parallelOptions, (n) =>
+                {
+                    byte[] key = (byte[])layouts[n / assignmentCount].Clone();
+                    int assignment = n % assignmentCount;
+                    for (int i = cubeCount - 1; i >= 0; i--)
+                    {
+                        key[i * keyBytesPerElement] = (byte)(assignment % rawElementCount);
+                        assignment /= rawElementCount;
+                    }
+
+                    byte[] entry = new byte[entrySize];
+                    if (!BuildOutcomeTableEntry(key, entry))
+                    { throw new InvalidOperationException("The game rejected a layout generated by this tool."); }
+
+                    if (entry[keySize] > 0) // Only layouts that form compounds are stored.
+                    { results[n] = entry; }
+                });
+
+                int formedCount = 0;
+                foreach (byte[] entry in results)
+                {
+                    if (entry != null)
+                    {
+                        entries.Add(entry);
+                        formedCount++;
+                    }
+                }
+
+                Console.WriteLine("{0} elements: {1} layouts with {2} element assignments each, {3} of which form compounds.", cubeCount, layouts.Count, assignmentCount, formedCount);
+            }
+
+            entries.Sort(CompareKeys);
+
+            // Output the table:
+            using (BinaryWriter writer = new BinaryWriter(File.Create(outputFile), Encoding.ASCII))
+            {
+                writer.Write(Encoding.ASCII.GetBytes(imageMagic));
+                writer.Write((byte)imageVersion);
+                writer.Write((byte)elementCount);
+                writer.Write((ushort)headerSize);
+                writer.Write(GetCompoundDatabaseHash());
+                writer.Write((uint)entries.Count);
+
+                foreach (byte[] entry in entries)
+                { writer.Write(entry); }
+            }
+
+            Console.WriteLine("Wrote {0} outcomes into {1} bytes.", entries.Count, headerSize + entries.Count * entrySize);
+            return 0;
+        }
+    }
+}
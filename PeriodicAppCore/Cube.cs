@@ -95,21 +95,27 @@ namespace PeriodicAppCore
         public virtual void Paint()
         {
             // Back up the neighbors array so that the cubes get the state that is accurate to the events they've received rather than
-            // the live version. We also use this to call OnNeighborsChanged and inform Periodic that the neighborhoods have changed.
+            // the live version. We also use this to call OnNeighborsChanged and inform Periodic of the neighbors that changed.
             neighborhoodIsStale = false;
             for (int i = 0; i < neighbors.Length; i++)
             {
                 if (lastNeighbors[i] != neighbors[i])
                 {
+                    QueueNeighborEvents((Side)i, lastNeighbors[i], neighbors[i]);
                     lastNeighbors[i] = neighbors[i];
                     neighborhoodIsStale = true;
                 }
             }
+        }
 
-            if (neighborhoodIsStale)
-            {
-                Periodic.MarkNeighborhoodsAsStale();
-            }
+        private void QueueNeighborEvents(Side side, Cube oldNeighbor, Cube newNeighbor)
+        {
+            // Both cubes see every change, so the event for a pair of cubes is only sent by the cube that was given to Periodic first.
+            if (oldNeighbor != null && Periodic.IsFirstOfPair(this, oldNeighbor))
+            { Periodic.OnNeighborRemove(this, side, oldNeighbor, side.GetOpposite()); }
+
+            if (newNeighbor != null && Periodic.IsFirstOfPair(this, newNeighbor))
+            { Periodic.OnNeighborAdd(this, side, newNeighbor, side.GetOpposite()); }
         }
 
         //HACK: This is kinda weird to get around issues with deadlocking with Invoke in OnNeighborsChanged.
@@ -13,11 +13,11 @@ namespace PeriodicAppCore
         [DllImport(periodicDll, EntryPoint = "main", CallingConvention = CallingConvention.Cdecl)]
         private static extern void MainThread();
 
-        //[DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
-        //private static extern void OnNeighborAdd(IntPtr sender, uint firstId, uint firstSide, uint secondId, uint secondSide);
+        [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void OnNeighborAdd(IntPtr sender, uint firstId, uint firstSide, uint secondId, uint secondSide);
 
-        //[DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
-        //private static extern void OnNeighborRemove(IntPtr sender, uint firstId, uint firstSide, uint secondId, uint secondSide);
+        [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void OnNeighborRemove(IntPtr sender, uint firstId, uint firstSide, uint secondId, uint secondSide);
 
         [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
         private static extern void OnNeighborhoodChanged();
@@ -31,6 +31,22 @@ namespace PeriodicAppCore
         [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
         public static extern void RequestStop();
 
+        [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
+        private static extern uint GetReactionSearchCount();
+
+        [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        private static extern bool GetReactionPatternStats(int pattern, out ReactionPatternStats stats);
+
+        [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr GetReactionPatternName(int pattern);
+
+        [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void ResetReactionStats();
+
+        [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void LogReactionStats();
+
         [DllImport(periodicDll, CallingConvention = CallingConvention.Cdecl)]
         private static extern void InstallCallbacks
             (
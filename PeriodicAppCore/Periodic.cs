@@ -1,6 +1,7 @@
 ﻿using System;
 using System.Collections.Generic;
 using System.Diagnostics;
+using System.Runtime.InteropServices;
 using System.Threading;
 
 namespace PeriodicAppCore
@@ -35,6 +36,34 @@ namespace PeriodicAppCore
             neighborhoodsAreStale = true;
         }
 
+        // Checks if the first cube is the one of the pair that reports neighbor events for the pair. (Cubes that aren't part of the simulation never do.)
+        internal static bool IsFirstOfPair(Cube first, Cube second)
+        {
+            int firstId = GetCubeId(first);
+            int secondId = GetCubeId(second);
+            return firstId >= 0 && secondId >= 0 && firstId < secondId;
+        }
+
+        internal static void OnNeighborAdd(Cube first, Side firstSide, Cube second, Side secondSide)
+        {
+            if (first == null)
+            { throw new ArgumentNullException("first"); }
+            if (second == null)
+            { throw new ArgumentNullException("second"); }
+
+            pendingEvents.Enqueue(() => OnNeighborAdd(IntPtr.Zero, (uint)GetCubeId(first), (uint)firstSide, (uint)GetCubeId(second), (uint)secondSide));
+        }
+
+        internal static void OnNeighborRemove(Cube first, Side firstSide, Cube second, Side secondSide)
+        {
+            if (first == null)
+            { throw new ArgumentNullException("first"); }
+            if (second == null)
+            { throw new ArgumentNullException("second"); }
+
+            pendingEvents.Enqueue(() => OnNeighborRemove(IntPtr.Zero, (uint)GetCubeId(first), (uint)firstSide, (uint)GetCubeId(second), (uint)secondSide));
+        }
+
         private static void Log(string message)
         {
             Debug.Write(message, "Periodic");
@@ -154,6 +183,25 @@ namespace PeriodicAppCore
             cubes.Add(cube);
         }
 
+        // The number of times reactions have searched the compound database since the reaction statistics were reset
+        public static int ReactionSearchCount
+        {
+            get { return (int)GetReactionSearchCount(); }
+        }
+
+        // Gets the reaction search statistics of the given compound database pattern, returns false once there are no more patterns.
+        public static bool TryGetReactionPatternStats(int pattern, out string name, out ReactionPatternStats stats)
+        {
+            if (!GetReactionPatternStats(pattern, out stats))
+            {
+                name = null;
+                return false;
+            }
+
+            name = Marshal.PtrToStringAnsi(GetReactionPatternName(pattern));
+            return true;
+        }
+
         public static event EventHandler Stopped;
 
         private static Thread thread;
@@ -0,0 +1,18 @@
+﻿using System.Runtime.InteropServices;
+
+namespace PeriodicAppCore
+{
+    // Counters describing how much work the reaction search has done for a single compound database pattern.
+    // This must match ReactionPatternStats in ReactionStats.h.
+    [StructLayout(LayoutKind.Sequential)]
+    public struct ReactionPatternStats
+    {
+        public uint NodesVisited;
+        public uint OutputCalls;
+        public uint Backtracks;
+        public uint MasksCleared;
+        public uint PatternsTried;
+        public uint PatternsFailed;
+        public uint Microseconds;
+    }
+}
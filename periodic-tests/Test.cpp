@@ -6,7 +6,7 @@
 //! Should only ever be set to true by testing functions, never false.
 static bool testIsFailing = false;
 
-#define TEST_STEP_COUNT 6
+#define TEST_STEP_COUNT 10
 
 static int numVerifications;
 static int numVerificationsFailing;
@@ -19,7 +19,11 @@ static char testSteps[TEST_STEP_COUNT][40] = // TODO: Make it so all this doesn'
     "TestStep_2ElementsCovalentBonds: ",
     "TestStep_2ElementsInoicBonds:    ",
     "TestStep_3ElementsBonds:         ",
-    "TestStep_ObjectPool:             "
+    "TestStep_MultipleCompounds:      ",
+    "TestStep_ObjectPool:             ",
+    "TestStep_ReactionCache:          ",
+    "TestStep_ReactionStats:          ",
+    "TestStep_OutcomeTable:           "
 };
 
 //! Prefix used for messages printed by the testing framework.
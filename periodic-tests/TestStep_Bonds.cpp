@@ -3,7 +3,7 @@
 #include "periodic.h"
 #include "Element.h"
 #include "Reaction.h"
-#include "BondSolution.h"
+#include "Bond.h"
 
 //! Supporting function for TestCovalentBond
 void __TestCovalentBond(const char* a, const char* b, int numElectronsShared, const char* message)
@@ -120,6 +120,64 @@ void __TestTripleBond(const char* a, const char* b, const char* c, BondType expe
     }
 }
 
+//! Supporting function for TestTwoCompounds
+//! Reacts a horizontal chain of a, b, c and d where a and b form one compound and c and d form another.
+void __TestTwoCompounds(const char* a, const char* b, const char* c, const char* d, const char* message)
+{
+    // Load the elements
+    Element elements[4];
+    Element expected[4];
+    const char* symbols[4] = { a, b, c, d };
+    TestMessage(message);
+    for (int i = 0; i < 4; i++)
+    {
+        TestEqBool("Get the element", Element::GetRawElement(symbols[i], &elements[i]), true);
+        TestEqBool("Get the expected element", Element::GetRawElement(symbols[i], &expected[i]), true);
+    }
+
+    // React each pair on its own to find the expected result
+    for (int i = 0; i < 4; i += 2)
+    {
+        Reaction reaction;
+        reaction.Add(&expected[i]);
+        expected[i].AddBond(BondSide_Right, &expected[i + 1]);
+        TestEqBool("Check that the pair reacts on its own", reaction.Process(), true);
+    }
+
+    // Create a reaction with the whole chain and process it
+    Reaction reaction;
+    reaction.Add(&elements[0]);
+    for (int i = 1; i < 4; i++)
+    { elements[i - 1].AddBond(BondSide_Right, &elements[i]); }
+    TestEqBool("Check that a reaction occurs", reaction.Process(), true);
+
+    // Verify that both compounds formed
+    for (int i = 0; i < 4; i++)
+    {
+        TestEqInt("Check the element's charge after the reaction", elements[i].GetCharge(), expected[i].GetCharge());
+        TestEqInt("Check the element's shared electron number after the reaction", elements[i].GetSharedElectrons(), expected[i].GetSharedElectrons());
+    }
+}
+
+//! Reacts a horizontal chain of NUM_CUBES elements that alternates between a cation and an anion which ionically bond with a charge of 1.
+//! This is the largest reaction there can be, and every element is expected to end up in a compound.
+void TestLongIonicChain(const char* cation, const char* anion)
+{
+    Element elements[NUM_CUBES];
+    TestMessage("React a chain of alternating elements as long as there are cubes");
+    for (int i = 0; i < NUM_CUBES; i++)
+    { TestEqBool("Get the element", Element::GetRawElement(i % 2 == 0 ? cation : anion, &elements[i]), true); }
+
+    Reaction reaction;
+    reaction.Add(&elements[0]);
+    for (int i = 1; i < NUM_CUBES; i++)
+    { elements[i - 1].AddBond(BondSide_Right, &elements[i]); }
+    TestEqBool("Check that a reaction occurs", reaction.Process(), true);
+
+    for (int i = 0; i < NUM_CUBES; i++)
+    { TestEqInt("Check the element's charge after the reaction", elements[i].GetCharge(), i % 2 == 0 ? 1 : -1); }
+}
+
 //! Supporting macro for TestCovalentBond
 #define _TestCovalentBond(a, b, numElectronsShared) __TestCovalentBond(a, b, numElectronsShared, "React " a " and " b " with expected electrons shared count of " #numElectronsShared)
 //! Supporting macro for TestIonicBond
@@ -139,6 +197,12 @@ void __TestTripleBond(const char* a, const char* b, const char* c, BondType expe
 //! This is a supporting macro that ensures all bonds are covered.
 #define TestTripleBond(a, b, c, expectedBondType) _TestTripleBond(a, b, c, expectedBondType); _TestTripleBond(c, b, a, expectedBondType)
 
+//! Tests that two compounds form when their elements are chained together in one reaction.
+//! This is a supporting macro that ensures the chain works in both directions.
+#define TestTwoCompounds(a, b, c, d) \
+    __TestTwoCompounds(a, b, c, d, "React " a "-" b " next to " c "-" d); \
+    __TestTwoCompounds(d, c, b, a, "React " d "-" c " next to " b "-" a)
+
 void TestStep_Bonds()
 {
     TestStart();
@@ -222,6 +286,15 @@ void TestStep_Bonds()
     TestTripleBond("I" , "Ba", "I" , BondType_Ionic);
     TestTripleBond("At", "Ba", "At", BondType_Ionic);
     TestEnd();
+
+    TestStart();
+    TestMessage("Test multiple compounds in one reaction");
+    TestTwoCompounds("H", "F", "Li", "I");
+    TestTwoCompounds("H", "H", "F", "F");
+    TestTwoCompounds("Li", "I", "Na", "Cl");
+    TestLongIonicChain("Li", "F");
+    TestLongIonicChain("Na", "Cl");
+    TestEnd();
 #if 0  
 #endif  
 }
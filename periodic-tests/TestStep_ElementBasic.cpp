@@ -1,6 +1,7 @@
 #include "TestSteps.h"
 #include "Test.h"
 #include "Element.h"
+#include "Reaction.h"
 
 void TestStep_ElementBasic()
 {
@@ -9,4 +10,45 @@ void TestStep_ElementBasic()
     TestMessage("Test GetRawElement with a symbol name.");
     Element::GetRawElement("Kr", &e);
     TestEqString("Check if Krypton is returned for symbol 'Kr'", e.GetName(), "Krypton");
+
+    TestMessage("Test GetRawElementNum with every raw element's symbol.");
+    for (int i = 0; i < Element::GetRawElementCount(); i++)
+    {
+        Element::GetRawElement(i, &e);
+        TestEqInt("Check that the symbol maps back to its raw element", Element::GetRawElementNum(e.GetSymbol()), i);
+    }
+
+    TestMessage("Test GetRawElementNum with symbols that aren't raw elements.");
+    TestEqInt("Check that an empty symbol isn't found", Element::GetRawElementNum(""), -1);
+    TestEqInt("Check that an unknown symbol isn't found", Element::GetRawElementNum("Xe"), -1);
+    TestEqInt("Check that a symbol with the wrong case isn't found", Element::GetRawElementNum("CL"), -1);
+    TestEqInt("Check that a symbol that is too long isn't found", Element::GetRawElementNum("Hel"), -1);
+
+    TestMessage("Test that ResetToBasicState undoes a reaction.");
+    Element na;
+    Element cl;
+    Element::GetRawElement("Na", &na);
+    Element::GetRawElement("Cl", &cl);
+    {
+        Reaction reaction;
+        reaction.Add(&na);
+        na.AddBond(BondSide_Right, &cl);
+        TestEqBool("Check that a reaction occurs", reaction.Process(), true);
+        TestEqInt("Check the chlorine's charge after the reaction", cl.GetCharge(), -1);
+
+        na.ResetToBasicState();
+        cl.ResetToBasicState();
+    }
+    TestEqInt("Check the sodium's charge after the reset", na.GetCharge(), 0);
+    TestEqInt("Check the chlorine's charge after the reset", cl.GetCharge(), 0);
+    TestEqInt("Check the chlorine's outer electrons after the reset", cl.GetNumOuterElectrons(), 7);
+    TestEqBool("Check that the sodium has no neighbor after the reset", na.GetBondWith(BondSide_Right) == NULL, true);
+    TestEqInt("Check that the sodium's bond is gone after the reset", na.GetBondTypeFor(BondSide_Right), BondType_None);
+
+    TestMessage("Test that reset elements can react again.");
+    Reaction reaction;
+    reaction.Add(&cl);
+    cl.AddBond(BondSide_Left, &na);
+    TestEqBool("Check that a reaction occurs", reaction.Process(), true);
+    TestEqInt("Check the sodium's charge after the reaction", na.GetCharge(), 1);
 }
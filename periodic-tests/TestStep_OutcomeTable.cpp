@@ -0,0 +1,129 @@
+#include "TestSteps.h"
+#include "Test.h"
+#include "periodic.h"
+#include "Element.h"
+#include "Reaction.h"
+#include "ReactionCache.h"
+#include "OutcomeTable.h"
+#include "CompoundDatabase.h"
+
+#define MAX_TEST_TABLE_ENTRIES 4
+
+//! An outcome table image built by the test, kept in uint32s so that it is aligned like a mapped file.
+static uint32 tableImage[(sizeof(OutcomeTableHeader) + MAX_TEST_TABLE_ENTRIES * sizeof(OutcomeTableEntry)) / sizeof(uint32)];
+
+static OutcomeTableEntry* GetTableEntries()
+{
+    return (OutcomeTableEntry*)((OutcomeTableHeader*)tableImage + 1);
+}
+
+//! Builds the outcome table key of a horizontal chain of two elements.
+static void MakeChainKey(const char* first, const char* second, uint8* keyOut)
+{
+    PeriodicMemset(keyOut, REACTION_KEY_NO_NEIGHBOR, OUTCOME_TABLE_KEY_SIZE);
+    keyOut[0] = (uint8)Element::GetRawElementNum(first);
+    keyOut[1 + BondSide_Right] = 1;
+    keyOut[REACTION_KEY_BYTES_PER_ELEMENT] = (uint8)Element::GetRawElementNum(second);
+    keyOut[REACTION_KEY_BYTES_PER_ELEMENT + 1 + BondSide_Left] = 0;
+}
+
+//! Builds an outcome table image for up to two elements from the given chains and returns its size.
+//! The chains must be given in key order, which is the order of their raw elements.
+static uint32 BuildTable(const char** chains, int chainCount, uint32 databaseHash)
+{
+    Assert(chainCount <= MAX_TEST_TABLE_ENTRIES);
+    OutcomeTableHeader* header = (OutcomeTableHeader*)tableImage;
+    OutcomeTableEntry* entries = GetTableEntries();
+
+    for (int i = 0; i < 4; i++)
+    { header->magic[i] = OUTCOME_TABLE_MAGIC[i]; }
+    header->version = OUTCOME_TABLE_VERSION;
+    header->maxElementCount = 2;
+    header->entriesOffset = sizeof(OutcomeTableHeader);
+    header->databaseHash = databaseHash;
+    header->entryCount = chainCount;
+
+    for (int i = 0; i < chainCount; i++)
+    {
+        uint8 key[OUTCOME_TABLE_KEY_SIZE];
+        MakeChainKey(chains[i * 2], chains[i * 2 + 1], key);
+        TestEqBool("Check that the entry could be built", OutcomeTable::BuildEntry(key, &entries[i]), true);
+    }
+
+    return sizeof(OutcomeTableHeader) + chainCount * sizeof(OutcomeTableEntry);
+}
+
+//! Reacts the given chain without and then with the outcome table loaded, and verifies the table answers it with the same outcome.
+static void TestTableChain(const char* first, const char* second, bool expectedResult)
+{
+    const char* symbols[] = { first, second };
+    int charges[2][2];
+    int sharedElectrons[2][2];
+
+    ReactionCache::Clear();
+    TestEqBool("Check the result of the searched reaction", __ReactChain(symbols, 2, charges[0], sharedElectrons[0]), expectedResult);
+
+    uint32 misses = ReactionCache::GetMissCount();
+    TestEqBool("Check the result of the table reaction", __ReactChain(symbols, 2, charges[1], sharedElectrons[1]), expectedResult);
+    TestEqUint("Check that the table reaction never reached the cache", ReactionCache::GetMissCount(), misses);
+
+    for (int i = 0; i < 2; i++)
+    {
+        TestEqInt("Check that the table charge matches", charges[1][i], charges[0][i]);
+        TestEqInt("Check that the table shared electron count matches", sharedElectrons[1][i], sharedElectrons[0][i]);
+    }
+}
+
+void TestStep_OutcomeTable()
+{
+    // Hydrogen comes before fluorine and iodine in the raw elements, so these chains are in key order:
+    const char* chains[] = { "H", "H", "H", "F", "H", "I" };
+    const char* lithiumIodide[] = { "Li", "I" };
+    const char* berylliumFluoride[] = { "F", "Be", "F" };
+    OutcomeTable::Unload();
+
+    TestMessage("Verify that invalid layouts are rejected");
+    {
+        uint8 key[OUTCOME_TABLE_KEY_SIZE];
+        OutcomeTableEntry entry;
+        MakeChainKey("H", "F", key);
+        key[REACTION_KEY_BYTES_PER_ELEMENT + 1 + BondSide_Left] = REACTION_KEY_NO_NEIGHBOR;
+        TestEqBool("Check that a bond listed by one element is rejected", OutcomeTable::BuildEntry(key, &entry), false);
+        MakeChainKey("H", "F", key);
+        key[REACTION_KEY_BYTES_PER_ELEMENT] = REACTION_KEY_NO_NEIGHBOR;
+        TestEqBool("Check that a single element is rejected", OutcomeTable::BuildEntry(key, &entry), false);
+    }
+
+    TestMessage("Verify that invalid tables are rejected");
+    uint32 size = BuildTable(chains, 3, CompoundDatabase::GetImageHash());
+    TestEqBool("Check that a truncated table is rejected", OutcomeTable::Load(tableImage, size - 1), false);
+    OutcomeTableEntry swap = GetTableEntries()[0];
+    GetTableEntries()[0] = GetTableEntries()[1];
+    GetTableEntries()[1] = swap;
+    TestEqBool("Check that an unsorted table is rejected", OutcomeTable::Load(tableImage, size), false);
+    TestEqBool("Check that no table was loaded", OutcomeTable::IsLoaded(), false);
+
+    TestMessage("Verify that table outcomes match searched outcomes");
+    size = BuildTable(chains, 3, CompoundDatabase::GetImageHash());
+    TestEqBool("Check that the table loads", OutcomeTable::Load(tableImage, size), true);
+    TestTableChain("H", "H", true);
+    TestTableChain("H", "F", true);
+    TestTableChain("H", "I", true);
+
+    TestMessage("Verify that layouts missing from the table don't form compounds");
+    TestEqBool("Check that Li-I doesn't react", __ReactChain(lithiumIodide, 2, NULL, NULL), false);
+
+    TestMessage("Verify that larger reactions are searched");
+    ReactionCache::Clear();
+    uint32 misses = ReactionCache::GetMissCount();
+    TestEqBool("Check that F-Be-F reacts", __ReactChain(berylliumFluoride, 3, NULL, NULL), true);
+    TestEqUint("Check that the reaction missed the cache", ReactionCache::GetMissCount(), misses + 1);
+
+    TestMessage("Verify that tables from other compound databases aren't used");
+    OutcomeTable::Unload();
+    size = BuildTable(chains, 3, CompoundDatabase::GetImageHash() + 1);
+    TestEqBool("Check that the table loads", OutcomeTable::Load(tableImage, size), true);
+    TestEqBool("Check that Li-I reacts", __ReactChain(lithiumIodide, 2, NULL, NULL), true);
+
+    OutcomeTable::Unload();
+}
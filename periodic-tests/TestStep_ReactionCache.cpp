@@ -0,0 +1,91 @@
+#include "TestSteps.h"
+#include "Test.h"
+#include "periodic.h"
+#include "Element.h"
+#include "Reaction.h"
+#include "ReactionCache.h"
+#include "CompoundDatabase.h"
+
+//! Reacts a horizontal chain of elements and records the state of each element afterwards.
+//! Returns the result of processing the reaction. chargesOut and sharedElectronsOut may be NULL if the state isn't needed.
+bool __ReactChain(const char** symbols, int count, int* chargesOut, int* sharedElectronsOut)
+{
+    Element elements[MAX_TEST_CHAIN_LENGTH];
+    Assert(count <= MAX_TEST_CHAIN_LENGTH);
+
+    for (int i = 0; i < count; i++)
+    { Element::GetRawElement(symbols[i], &elements[i]); }
+
+    Reaction reaction;
+    reaction.Add(&elements[0]);
+    for (int i = 1; i < count; i++)
+    { elements[i - 1].AddBond(BondSide_Right, &elements[i]); }
+
+    bool ret = reaction.Process();
+    if (chargesOut == NULL || sharedElectronsOut == NULL)
+    { return ret; }
+
+    for (int i = 0; i < count; i++)
+    {
+        chargesOut[i] = elements[i].GetCharge();
+        sharedElectronsOut[i] = elements[i].GetSharedElectrons();
+    }
+
+    return ret;
+}
+
+//! Reacts the given chain twice, and verifies the second reaction comes from the cache and has the same outcome as the first.
+void __TestCachedChain(const char** symbols, int count, bool expectedResult, const char* message)
+{
+    int charges[2][MAX_TEST_CHAIN_LENGTH];
+    int sharedElectrons[2][MAX_TEST_CHAIN_LENGTH];
+    TestMessage(message);
+
+    ReactionCache::Clear();
+    uint32 hits = ReactionCache::GetHitCount();
+    uint32 misses = ReactionCache::GetMissCount();
+
+    TestEqBool("Check the result of the first reaction", __ReactChain(symbols, count, charges[0], sharedElectrons[0]), expectedResult);
+    TestEqUint("Check that the first reaction missed the cache", ReactionCache::GetMissCount(), misses + 1);
+    TestEqBool("Check the result of the second reaction", __ReactChain(symbols, count, charges[1], sharedElectrons[1]), expectedResult);
+    TestEqUint("Check that the second reaction hit the cache", ReactionCache::GetHitCount(), hits + 1);
+
+    for (int i = 0; i < count; i++)
+    {
+        TestEqInt("Check that the cached charge matches", charges[1][i], charges[0][i]);
+        TestEqInt("Check that the cached shared electron count matches", sharedElectrons[1][i], sharedElectrons[0][i]);
+    }
+}
+
+#define TestCachedChain(expectedResult, ...) \
+    { const char* symbols[] = { __VA_ARGS__ }; __TestCachedChain(symbols, CountOfArray(symbols), expectedResult, "React " #__VA_ARGS__ " twice"); }
+
+void TestStep_ReactionCache()
+{
+    TestCachedChain(true, "H", "F");
+    TestCachedChain(true, "Li", "I");
+    TestCachedChain(true, "F", "Be", "F");
+    TestCachedChain(true, "H", "Ca", "H");
+    TestCachedChain(true, "H", "C", "C", "H");
+    TestCachedChain(false, "H", "Be", "F");
+
+    TestMessage("Verify that reactions that can't form anything skip the cache");
+    {
+        const char* symbols[] = { "He", "Ne" };
+        int charges[2];
+        int sharedElectrons[2];
+        uint32 misses = ReactionCache::GetMissCount();
+        TestEqBool("Check the result of the reaction", __ReactChain(symbols, 2, charges, sharedElectrons), false);
+        TestEqUint("Check that the reaction never reached the cache", ReactionCache::GetMissCount(), misses);
+    }
+
+    TestMessage("Verify that loading the compound database clears the cache");
+    const char* symbols[] = { "H", "H" };
+    int charges[2];
+    int sharedElectrons[2];
+    __ReactChain(symbols, 2, charges, sharedElectrons);
+    CompoundDatabase::LoadDefault();
+    uint32 misses = ReactionCache::GetMissCount();
+    __ReactChain(symbols, 2, charges, sharedElectrons);
+    TestEqUint("Check that the reaction missed the cache", ReactionCache::GetMissCount(), misses + 1);
+}
@@ -0,0 +1,118 @@
+#include "TestSteps.h"
+#include "Test.h"
+#include "periodic.h"
+#include "Element.h"
+#include "Reaction.h"
+#include "ReactionCache.h"
+#include "ReactionStats.h"
+#include "CompoundDatabase.h"
+
+//! Returns the number of the pattern with the given name in the current compound database.
+static int FindPattern(const char* name)
+{
+    for (int i = 0; i < CompoundDatabase::GetPatternCount(); i++)
+    {
+        if (strcmp(CompoundDatabase::GetPatternName(i), name) == 0)
+        { return i; }
+    }
+
+    AssertAlways();
+    return -1;
+}
+
+//! Reacts a phosphorus surrounded by oxygens on three sides, with a column of four hydrogens below it that don't touch any of the oxygens.
+static bool ReactPhosphorusWithoutHydroxides()
+{
+    Element elements[8];
+    Element::GetRawElement("P", &elements[0]);
+    for (int i = 1; i < 4; i++)
+    { Element::GetRawElement("O", &elements[i]); }
+    for (int i = 4; i < 8; i++)
+    { Element::GetRawElement("H", &elements[i]); }
+
+    Reaction reaction;
+    reaction.Add(&elements[0]);
+    elements[0].AddBond(BondSide_Left, &elements[1]);
+    elements[0].AddBond(BondSide_Top, &elements[2]);
+    elements[0].AddBond(BondSide_Right, &elements[3]);
+    elements[0].AddBond(BondSide_Bottom, &elements[4]);
+    for (int i = 5; i < 8; i++)
+    { elements[i - 1].AddBond(BondSide_Bottom, &elements[i]); }
+
+    return reaction.Process();
+}
+
+//! Reacts a phosphorus surrounded by oxygens, where every oxygen except the one on the left has a hydrogen on its far side.
+static bool ReactPhosphorousAcidWithBareOxygen()
+{
+    Element elements[8];
+    Element::GetRawElement("P", &elements[0]);
+    for (int i = 1; i < 5; i++)
+    { Element::GetRawElement("O", &elements[i]); }
+    for (int i = 5; i < 8; i++)
+    { Element::GetRawElement("H", &elements[i]); }
+
+    Reaction reaction;
+    reaction.Add(&elements[0]);
+    elements[0].AddBond(BondSide_Left, &elements[1]);
+    elements[0].AddBond(BondSide_Top, &elements[2]);
+    elements[0].AddBond(BondSide_Right, &elements[3]);
+    elements[0].AddBond(BondSide_Bottom, &elements[4]);
+    elements[2].AddBond(BondSide_Top, &elements[5]);
+    elements[3].AddBond(BondSide_Right, &elements[6]);
+    elements[4].AddBond(BondSide_Bottom, &elements[7]);
+
+    return reaction.Process();
+}
+
+void TestStep_ReactionStats()
+{
+    ReactionCache::Clear();
+    ReactionStats::Reset();
+    ReactionPatternStats* hydrogenHalogen = ReactionStats::GetPatternStats(FindPattern("Hydrogen_Halogen"));
+    ReactionPatternStats* acetylene = ReactionStats::GetPatternStats(FindPattern("Acetylene"));
+    const char* hydrogenFluoride[] = { "H", "F" };
+    const char* hydrogenBerylliumFluorine[] = { "H", "Be", "F" };
+
+    TestMessage("Verify that a successful pattern is counted");
+    TestEqBool("Check that H-F reacts", __ReactChain(hydrogenFluoride, 2, NULL, NULL), true);
+    TestEqUint("Check the search count", ReactionStats::GetSearchCount(), 1);
+    TestEqUint("Check that the pattern was tried once", hydrogenHalogen->patternsTried, 1);
+    TestEqUint("Check that the pattern didn't fail", hydrogenHalogen->patternsFailed, 0);
+    TestEqBool("Check that nodes were visited", hydrogenHalogen->nodesVisited > 0, true);
+    TestEqBool("Check that every node looked for an output", hydrogenHalogen->outputCalls >= hydrogenHalogen->nodesVisited, true);
+    TestEqBool("Check that masks were cleared", hydrogenHalogen->masksCleared > 0, true);
+    TestEqUint("Check that patterns that can't fit weren't tried", acetylene->patternsTried, 0);
+
+    TestMessage("Verify that cached reactions don't search");
+    __ReactChain(hydrogenFluoride, 2, NULL, NULL);
+    TestEqUint("Check the search count", ReactionStats::GetSearchCount(), 1);
+
+    TestMessage("Verify that roots without the neighbors a pattern needs aren't tried");
+    TestEqBool("Check that H-Be-F doesn't react", __ReactChain(hydrogenBerylliumFluorine, 3, NULL, NULL), false);
+    TestEqUint("Check the search count", ReactionStats::GetSearchCount(), 2);
+    TestEqUint("Check that the pattern wasn't tried from the hydrogen without a halogen", hydrogenHalogen->patternsTried, 1);
+    TestEqUint("Check that the pattern didn't fail", hydrogenHalogen->patternsFailed, 0);
+
+    TestMessage("Verify that patterns which share a prefix that failed aren't tried");
+    ReactionPatternStats* phosphorousAcid1 = ReactionStats::GetPatternStats(FindPattern("PhosphorousAcid1"));
+    ReactionPatternStats* phosphorousAcid2 = ReactionStats::GetPatternStats(FindPattern("PhosphorousAcid2"));
+    ReactPhosphorusWithoutHydroxides();
+    TestEqUint("Check that the first phosphorous acid was tried", phosphorousAcid1->patternsTried, 1);
+    TestEqUint("Check that it failed", phosphorousAcid1->patternsFailed, 1);
+    TestEqUint("Check that the second phosphorous acid was skipped", phosphorousAcid2->patternsTried, 0);
+
+    TestMessage("Verify that interchangeable nodes share their failures");
+    ReactionStats::Reset();
+    TestEqBool("Check that the phosphorous acid forms", ReactPhosphorousAcidWithBareOxygen(), true);
+    TestEqUint("Check that the first phosphorous acid matched", phosphorousAcid1->patternsFailed, 0);
+    // The root, each hydroxide's oxygen and hydrogen, and the hydrogen that wasn't found on the bare oxygen. Only the first hydroxide looks
+    // for that hydrogen, since the other two are its twins and the bare oxygen looks the same to them.
+    TestEqUint("Check the visited nodes", phosphorousAcid1->nodesVisited, 8);
+
+    TestMessage("Verify that the statistics can be reset");
+    ReactionStats::Reset();
+    TestEqUint("Check the search count", ReactionStats::GetSearchCount(), 0);
+    TestEqUint("Check the tried patterns", hydrogenHalogen->patternsTried, 0);
+    TestEqUint("Check the visited nodes", hydrogenHalogen->nodesVisited, 0);
+}
@@ -13,4 +13,19 @@ void TestStep_Bonds();
 //! Tests the operation of the ObjectPool allocator
 void TestStep_ObjectPool();
 
+//! Tests that cached reaction outcomes match the outcomes of processing the reaction
+void TestStep_ReactionCache();
+
+//! Tests that the reaction search statistics count the work done by each pattern
+void TestStep_ReactionStats();
+
+//! Tests that reactions answered by an outcome table match the outcomes of processing the reaction
+void TestStep_OutcomeTable();
+
+//! The most elements __ReactChain can react
+#define MAX_TEST_CHAIN_LENGTH 4
+
+//! Reacts a horizontal chain of elements and records the state of each element afterwards. (Defined in TestStep_ReactionCache.cpp)
+bool __ReactChain(const char** symbols, int count, int* chargesOut, int* sharedElectronsOut);
+
 #endif
@@ -2,6 +2,7 @@
 #include "Test.h"
 #include "TestSteps.h"
 #include "Element.h"
+#include "CompoundDatabase.h"
 #include <sifteo.h>
 
 using namespace Sifteo;
@@ -22,6 +23,7 @@ static Metadata M = Metadata()
 void main()
 {
     TestInit();
+    CompoundDatabase::LoadDefault();
     TestStart();
     RUN_TEST(TestStep_Strcmp);
     TestEnd();
@@ -32,6 +34,15 @@ void main()
     TestStart();
     RUN_TEST(TestStep_ObjectPool);
     TestEnd();
+    TestStart();
+    RUN_TEST(TestStep_ReactionCache);
+    TestEnd();
+    TestStart();
+    RUN_TEST(TestStep_ReactionStats);
+    TestEnd();
+    TestStart();
+    RUN_TEST(TestStep_OutcomeTable);
+    TestEnd();
 
     TestResultPrint();
     if (TestIsFailing())
@@ -1,33 +1,8 @@
 #include "Bond.h"
-#include "Element.h"
-#include "Compound.h"
 #include "periodic.h"
 
 #include <sifteo.h>
 
-Bond::Bond()
-{
-    with = NULL;
-    side = BondSide_Invalid;
-}
-
-Bond::Bond(BondSide side, Element* with)
-{
-    this->with = with;
-    this->side = side;
-    PeriodicMemset(solutions, 0, sizeof(solutions));
-}
-
-Element* Bond::GetElement()
-{
-    return with;
-}
-
-BondSide Bond::GetSide()
-{
-    return side;
-}
-
 BondSide Bond::GetOppositeSide(BondSide side)
 {
     switch (side)
@@ -45,45 +20,3 @@ BondSide Bond::GetOppositeSide(BondSide side)
         return BondSide_Invalid;
     }
 }
-
-BondType Bond::GetTypeFor(Compound* compound)
-{
-    if (compound == NULL)
-    { return BondType_None; }
-
-    BondSolution* solution = &solutions[compound->GetIndex()];
-    
-    if (solution->GetCompound() == NULL)
-    { return BondType_None; }
-
-    Assert(solution->GetCompound() == compound);
-    return solution->GetType();
-}
-
-void Bond::SetTypeFor(Compound* compound, BondType type, int data)
-{
-    BondSolution* solution = &solutions[compound->GetIndex()];
-    Assert(solution->GetCompound() == NULL || solution->GetCompound() == compound);
-    solutions[compound->GetIndex()] = BondSolution(compound, type, data);
-}
-
-void Bond::PurgeInfoFor(Compound* compound)
-{
-    BondSolution* solution = &solutions[compound->GetIndex()];
-    Assert(solution->GetCompound() == NULL || solution->GetCompound() == compound);
-    PeriodicMemset(solution, 0, sizeof(BondSolution));
-}
-
-int Bond::GetDataFor(Compound* compound)
-{
-    if (compound == NULL)
-    { return 0; }
-
-    BondSolution* solution = &solutions[compound->GetIndex()];
-
-    if (solution->GetCompound() == NULL)
-    { return 0; }
-
-    Assert(solution->GetCompound() == compound);
-    return solution->GetData();
-}
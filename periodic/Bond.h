@@ -1,12 +1,6 @@
 #ifndef __BOND_H__
 #define __BOND_H__
 
-#include "BondSolution.h"
-#include "Set.h"
-
-class Element;
-class Compound;
-
 enum BondSide // Should match order and values of Sifteo's Side type.
 {
     BondSide_Top,
@@ -17,25 +11,23 @@ enum BondSide // Should match order and values of Sifteo's Side type.
     BondSide_Invalid = -1
 };
 
+enum BondType
+{
+    BondType_None,
+    BondType_Ionic,
+    BondType_Covalent,
+    BondType_Potential,
+    BondType_Count,
+    BondType_Invalid
+};
+
+//! Utilities for the bonds between neighboring elements.
+//! Elements only know which element is on each of their sides, the bonds chosen for each side are recorded by the compound using them (see
+//! CompoundBond) since a reaction considers many compounds for the same elements.
 class Bond
 {
-private:
-    Element* with;
-    BondSide side;
-    BondSolution solutions[MAX_COMPOUNDS]; // TODO: Should we use a LinkedList here to save memory in the Element class?
 public:
-    Bond();
-    Bond(BondSide side, Element* with);
-
-    Element* GetElement();
-    BondSide GetSide();
-
     static BondSide GetOppositeSide(BondSide side);
-
-    BondType GetTypeFor(Compound* compound);
-    int GetDataFor(Compound* compound);
-    void SetTypeFor(Compound* compound, BondType type, int data);
-    void PurgeInfoFor(Compound* compound);
 };
 
 #endif
@@ -4,12 +4,15 @@
 #include "Bond.h"
 
 Compound::Compound()
-{}
+{
+    bondCount = 0;
+}
 
 Compound::Compound(int index)
 {
     this->index = index;
     elements.Clear();
+    bondCount = 0;
 }
 
 void Compound::AddElement(Element* element)
@@ -22,16 +25,18 @@ int Compound::GetElementCount()
     return elements.Count();
 }
 
+bool Compound::ContainsElement(Element* element)
+{
+    return elements.Contains(element);
+}
+
 bool Compound::ContainsPotentialBonds()
 {
-    for (int i = 0; i < elements.Count(); i++)
+    for (int i = 0; i < bondCount; i++)
     {
-        for (int side = 0; side < BondSide_Count; side++)
+        if (bonds[i].GetType() == BondType_Potential)
         {
-            if (elements[i]->GetBondTypeFor(this, (BondSide)side) == BondType_Potential)
-            {
-                return true;
-            }
+            return true;
         }
     }
 
@@ -50,3 +55,49 @@ void Compound::Apply()
         elements[i]->ApplyCompound(this);
     }
 }
+
+CompoundBond* Compound::FindBond(int slot, BondSide side)
+{
+    if (slot < 0)
+    { return NULL; }
+
+    int slotAndSide = CompoundBond(slot, side, BondType_None, 0).GetSlotAndSide();
+    for (int i = 0; i < bondCount; i++)
+    {
+        if (bonds[i].GetSlotAndSide() == slotAndSide)
+        { return &bonds[i]; }
+    }
+
+    return NULL;
+}
+
+BondType Compound::GetBondType(Element* element, BondSide side)
+{
+    CompoundBond* bond = FindBond(elements.IndexOf(element), side);
+    return bond == NULL ? BondType_None : bond->GetType();
+}
+
+int Compound::GetBondData(Element* element, BondSide side)
+{
+    CompoundBond* bond = FindBond(elements.IndexOf(element), side);
+    return bond == NULL ? 0 : bond->GetData();
+}
+
+void Compound::SetBond(Element* element, BondSide side, BondType type, int data)
+{
+    Assert(side >= 0 && side < BondSide_Count);
+    Assert(type >= 0 && type < BondType_Count);
+    Assert(data >= 0 && data <= 0xFF);
+
+    AddElement(element);
+    int slot = elements.IndexOf(element);
+    CompoundBond* bond = FindBond(slot, side);
+
+    if (bond == NULL)
+    {
+        Assert(bondCount < MAX_COMPOUND_BONDS);
+        bond = &bonds[bondCount++];
+    }
+
+    *bond = CompoundBond(slot, side, type, data);
+}
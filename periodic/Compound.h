@@ -4,23 +4,62 @@
 #include "Set.h"
 #include "ObjectPool.h"
 #include "ElementSet.h"
+#include "Bond.h"
 #include "periodic.h"
 
 class Reaction;
 
-class Compound : public ObjectPool<Compound, MAX_COMPOUNDS>
+//! The most bonds a compound can record: one for every side of every element.
+#define MAX_COMPOUND_BONDS (NUM_CUBES * BondSide_Count)
+
+//! The bond a compound uses on one side of one of its elements, packed into 16 bits:
+//! The element's slot in the compound (4 bits), the side (2 bits), the bond type (2 bits), and the bond data (8 bits, e.g. the order of a covalent bond).
+class CompoundBond
+{
+private:
+    uint16 bits;
+public:
+    CompoundBond() { }
+    CompoundBond(int slot, BondSide side, BondType type, int data)
+    { bits = (uint16)((slot << 12) | (side << 10) | (type << 8) | data); }
+
+    //! Returns a number identifying the element slot and side of this bond, unique within a compound.
+    int GetSlotAndSide() { return bits >> 10; }
+    BondType GetType() { return (BondType)((bits >> 8) & 3); }
+    int GetData() { return bits & 0xFF; }
+};
+CompilerAssert(NUM_CUBES <= 16); // Element slots are packed into 4 bits, so CompoundBond needs to grow along with NUM_CUBES past 16.
+CompilerAssert(BondSide_Count <= 4);
+CompilerAssert(BondType_Count <= 4);
+
+class Compound : public ObjectPool<Compound, COMPOUND_POOL_SIZE>
 {
 private:
     ElementSet elements;
     int index;
+    //! The bonds this compound uses, in the order they were set
+    CompoundBond bonds[MAX_COMPOUND_BONDS];
+    int bondCount;
+
+    //! Returns the bond on the given side of the element in the given slot, or NULL if this compound doesn't use that side.
+    CompoundBond* FindBond(int slot, BondSide side);
 public:
     Compound();
     Compound(int index);
     void AddElement(Element* element);
     int GetElementCount();
+    bool ContainsElement(Element* element);
     bool ContainsPotentialBonds();
     void Apply();
     int GetIndex();
+
+    //! Returns the type of the bond this compound uses on the given side of the given element, BondType_None if it doesn't use that side.
+    BondType GetBondType(Element* element, BondSide side);
+    //! Returns the data of the bond this compound uses on the given side of the given element, 0 if it doesn't use that side.
+    int GetBondData(Element* element, BondSide side);
+    //! Sets the bond this compound uses on the given side of the given element, adding the element to the compound if needed.
+    //! Only this side of the bond is set, the element on the other side keeps its own record of the bond.
+    void SetBond(Element* element, BondSide side, BondType type, int data);
 };
 
 #endif
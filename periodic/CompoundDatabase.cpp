@@ -0,0 +1,411 @@
+#include "CompoundDatabase.h"
+#include "Bond.h"
+#include "Element.h"
+#include "ReactionCache.h"
+#include "ReactionSnapshot.h"
+#include "ReactionStats.h"
+#include "compounds.gen.h"
+
+#include <sifteo.h>
+
+//------------------------------------------------------------------------------
+// Compile-time validation of the embedded compound database
+//------------------------------------------------------------------------------
+// CompoundGen rejects malformed patterns, but it doesn't know about the limits of the engine it's compiling for.
+CompilerAssert(COMPOUNDS_VERSION == COMPOUND_DATABASE_VERSION);
+CompilerAssert(COMPOUNDS_PATTERN_COUNT <= MAX_DATABASE_PATTERNS);
+CompilerAssert(COMPOUNDS_MAX_DEPTH < MAX_REACTION_DEPTH);
+CompilerAssert(COMPOUNDS_MAX_CHILDREN <= BondSide_Count);
+// Reaction::Evaluate needs room for one of its chosen compounds on top of the ideal compound kept by every other reaction.
+CompilerAssert(COMPOUND_POOL_SIZE > MAX_REACTIONS);
+
+//------------------------------------------------------------------------------
+// Current database
+//------------------------------------------------------------------------------
+static const CompoundDatabaseHeader* header = NULL;
+static const CompoundDatabasePattern* patterns = NULL;
+static const ReactionNode* nodes = NULL;
+static const uint32* prefixes = NULL;
+static const char* names = NULL;
+//! FNV-1a hash of the current image
+static uint32 imageHash = 0;
+
+//! Mask of the patterns whose root could accept each raw element
+static uint32 patternsByRawElement[MAX_RAW_ELEMENTS];
+//! The raw element numbers of the required symbols of each pattern (The image stores atomic numbers.)
+static uint8 requiredRawElements[MAX_DATABASE_PATTERNS][MAX_PATTERN_REQUIRED_SYMBOLS];
+//! The most elements each pattern could match
+static uint8 maxElementCounts[MAX_DATABASE_PATTERNS];
+//! The patterns ordered by maxElementCounts, largest first
+static uint8 patternsLargestFirst[MAX_DATABASE_PATTERNS];
+
+#ifdef STANDALONE_APP
+//! The image mapped by LoadFile, if it is the current database.
+static const void* mappedImage = NULL;
+#endif
+
+//------------------------------------------------------------------------------
+// Loading
+//------------------------------------------------------------------------------
+static bool InvalidImage(const char* reason)
+{
+    LOG("Compound database image is invalid: %s\n", reason);
+    return false;
+}
+
+//! Checks a single pattern of a compound database image, so that processing it can't read outside of the image.
+static bool ValidatePattern(const CompoundDatabaseHeader* newHeader, const CompoundDatabasePattern* pattern, const ReactionNode* newNodes, uint32 namesSize)
+{
+    if (pattern->nodeCount == 0 || pattern->firstNode + pattern->nodeCount > newHeader->nodeCount)
+    { return InvalidImage("Pattern has an invalid node range."); }
+
+    if (pattern->nameOffset >= namesSize)
+    { return InvalidImage("Pattern has an invalid name."); }
+
+    if (pattern->requiredSymbolCount > MAX_PATTERN_REQUIRED_SYMBOLS || pattern->rootNeighborSymbolCount > MAX_PATTERN_REQUIRED_SYMBOLS)
+    { return InvalidImage("Pattern has an invalid signature."); }
+
+    // The number of children seen so far for the most recent node at each depth
+    int childCounts[MAX_REACTION_DEPTH];
+
+    for (int i = 0; i < pattern->nodeCount; i++)
+    {
+        const ReactionNode* node = &newNodes[pattern->firstNode + i];
+
+        if (node->type >= ReactionNodeType_Count || node->bondType >= BondType_Count)
+        { return InvalidImage("Node has an invalid type."); }
+
+        if (node->group >= GROUP_COUNT && node->group != REACTION_NODE_NO_GROUP)
+        { return InvalidImage("Node has an invalid group."); }
+
+        if (node->twinOffset > i || (node->twinOffset != 0 && node[-node->twinOffset].depth != node->depth))
+        { return InvalidImage("Node has an invalid twin."); }
+
+        if (node->depth > newHeader->maxDepth)
+        { return InvalidImage("Node is deeper than the maximum depth."); }
+
+        if (i == 0 ? node->depth != 0 : (node->depth < 1 || node->depth > node[-1].depth + 1))
+        { return InvalidImage("Pattern nodes are not in pre-order."); }
+
+        if (node->depth > 0 && ++childCounts[node->depth - 1] > BondSide_Count)
+        { return InvalidImage("Node has more children than an element has sides."); }
+
+        childCounts[node->depth] = 0;
+    }
+
+    return true;
+}
+
+bool CompoundDatabase::Load(const void* image, uint32 size)
+{
+    const uint8* bytes = (const uint8*)image;
+    const CompoundDatabaseHeader* newHeader = (const CompoundDatabaseHeader*)image;
+
+    // Validate the header:
+    if (image == NULL || ((size_t)image & 3) != 0)
+    { return InvalidImage("Image is not aligned."); }
+
+    if (size < sizeof(CompoundDatabaseHeader) || newHeader->size > size)
+    { return InvalidImage("Image is truncated."); }
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (newHeader->magic[i] != COMPOUND_DATABASE_MAGIC[i])
+        { return InvalidImage("Image is not a compound database."); }
+    }
+
+    if (newHeader->version != COMPOUND_DATABASE_VERSION)
+    { return InvalidImage("Image was compiled for a different version of the game."); }
+
+    // Every depth a uint8 can hold fits in the standalone app's MAX_REACTION_DEPTH, but the device only has room for the depths of its own database.
+    if (newHeader->patternCount > MAX_DATABASE_PATTERNS || (int)newHeader->maxDepth + 1 > MAX_REACTION_DEPTH)
+    { return InvalidImage("Image exceeds the limits of this version of the game."); }
+
+    // Validate the tables:
+    size = newHeader->size;
+    if ((newHeader->patternsOffset % sizeof(uint32)) != 0 || newHeader->patternsOffset + newHeader->patternCount * sizeof(CompoundDatabasePattern) > size)
+    { return InvalidImage("Pattern table is out of bounds."); }
+
+    if (newHeader->nodesOffset + newHeader->nodeCount * sizeof(ReactionNode) > size)
+    { return InvalidImage("Node table is out of bounds."); }
+
+    if ((newHeader->prefixesOffset % sizeof(uint32)) != 0 || newHeader->prefixesOffset + newHeader->nodeCount * sizeof(uint32) > size)
+    { return InvalidImage("Prefix table is out of bounds."); }
+
+    // The image must end with a null character so that the last name is terminated.
+    if (newHeader->namesOffset >= size || bytes[size - 1] != '\0')
+    { return InvalidImage("Name table is out of bounds."); }
+
+    const CompoundDatabasePattern* newPatterns = (const CompoundDatabasePattern*)(bytes + newHeader->patternsOffset);
+    const ReactionNode* newNodes = (const ReactionNode*)(bytes + newHeader->nodesOffset);
+
+    for (int i = 0; i < newHeader->patternCount; i++)
+    {
+        if (!ValidatePattern(newHeader, &newPatterns[i], newNodes, size - newHeader->namesOffset))
+        { return false; }
+    }
+
+    // The image is good, so it becomes the current database:
+    ReactionCache::Clear(); // Cached outcomes came from the old database
+    ReactionStats::Reset(); // Statistics are kept by pattern number
+    header = newHeader;
+    patterns = newPatterns;
+    nodes = newNodes;
+    prefixes = (const uint32*)(bytes + newHeader->prefixesOffset);
+    names = (const char*)(bytes + newHeader->namesOffset);
+
+    // Hash the image so that data generated from it can be matched up with it later (see OutcomeTable):
+    imageHash = 2166136261u;
+    for (uint32 i = 0; i < size; i++)
+    {
+        imageHash ^= bytes[i];
+        imageHash *= 16777619u;
+    }
+
+    // Resolve the symbols required by each pattern to raw elements.
+    // A pattern that requires an element that isn't in the game can never match, so it is left out of the root index below.
+    uint32 impossiblePatterns = 0;
+    for (int p = 0; p < header->patternCount; p++)
+    {
+        for (int s = 0; s < patterns[p].requiredSymbolCount; s++)
+        {
+            int rawElement = -1;
+            for (int i = 0; i < Element::GetRawElementCount(); i++)
+            {
+                Element element;
+                Element::GetRawElement(i, &element);
+                if (element.GetAtomicNumber() == patterns[p].requiredAtomicNumbers[s])
+                {
+                    rawElement = i;
+                    break;
+                }
+            }
+
+            if (rawElement < 0)
+            {
+                LOG("Pattern %s requires an element that doesn't exist, it will never match.\n", names + patterns[p].nameOffset);
+                impossiblePatterns |= 1 << p;
+                rawElement = 0;
+            }
+
+            requiredRawElements[p][s] = (uint8)rawElement;
+        }
+    }
+
+    // Find the most elements each pattern could match: Its root, plus one for every node that bonds to a new element.
+    // (Only one branch of an EitherOr can match, so this overestimates patterns that use them. That's fine since this is only used as a bound.)
+    for (int p = 0; p < header->patternCount; p++)
+    {
+        int count = 1;
+        for (int i = 1; i < patterns[p].nodeCount; i++)
+        {
+            uint8 type = nodes[patterns[p].firstNode + i].type;
+            if (type == ReactionNodeType_ElementSymbol || type == ReactionNodeType_ElementGroup)
+            { count++; }
+        }
+
+        maxElementCounts[p] = (uint8)(count < 0xFF ? count : 0xFF);
+
+        // Insert the pattern into the largest first order after every pattern that is at least as large:
+        int position = p;
+        for (; position > 0 && maxElementCounts[patternsLargestFirst[position - 1]] < maxElementCounts[p]; position--)
+        { patternsLargestFirst[position] = patternsLargestFirst[position - 1]; }
+        patternsLargestFirst[position] = (uint8)p;
+    }
+
+    // Build the index of which patterns each raw element could be the root of:
+    for (int i = 0; i < Element::GetRawElementCount(); i++)
+    {
+        Element element;
+        Element::GetRawElement(i, &element);
+        patternsByRawElement[i] = 0;
+
+        for (int p = 0; p < header->patternCount; p++)
+        {
+            const ReactionNode* root = &nodes[patterns[p].firstNode];
+            bool canBeRoot;
+
+            switch (root->type)
+            {
+            case ReactionNodeType_ElementSymbolFilter:
+                canBeRoot = root->MatchesElement(&element);
+                break;
+            case ReactionNodeType_ElementGroupFilter:
+                canBeRoot = root->group == element.GetGroup();
+                break;
+            default:
+                canBeRoot = true; // Roots that don't filter their input could accept anything.
+                break;
+            }
+
+            if (canBeRoot)
+            { patternsByRawElement[i] |= 1 << p; }
+        }
+
+        patternsByRawElement[i] &= ~impossiblePatterns;
+    }
+
+    LOG("Loaded compound database with %d patterns and %d nodes.\n", header->patternCount, header->nodeCount);
+    return true;
+}
+
+void CompoundDatabase::LoadDefault()
+{
+    if (!Load(compounds, COMPOUNDS_SIZE))
+    { AssertAlways(); } // CompoundGen produced an invalid image, this should never happen.
+
+#ifdef STANDALONE_APP
+    if (mappedImage != NULL)
+    {
+        Sifteo::__unmap_file(mappedImage);
+        mappedImage = NULL;
+    }
+#endif
+}
+
+#ifdef STANDALONE_APP
+bool CompoundDatabase::LoadFile(const char* path)
+{
+    unsigned int size;
+    const void* image = Sifteo::__map_file(path, &size);
+
+    if (image == NULL)
+    {
+        LOG("Could not map compound database '%s'.\n", path);
+        return false;
+    }
+
+    if (!Load(image, size))
+    {
+        Sifteo::__unmap_file(image);
+        return false;
+    }
+
+    // The previous image is no longer in use now that the new one has been loaded.
+    if (mappedImage != NULL)
+    { Sifteo::__unmap_file(mappedImage); }
+
+    mappedImage = image;
+    return true;
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Queries
+//------------------------------------------------------------------------------
+int CompoundDatabase::GetPatternCount()
+{
+    Assert(header != NULL);
+    return header->patternCount;
+}
+
+uint32 CompoundDatabase::GetImageHash()
+{
+    Assert(header != NULL);
+    return imageHash;
+}
+
+const char* CompoundDatabase::GetPatternName(int pattern)
+{
+    Assert(pattern >= 0 && pattern < GetPatternCount());
+    return names + patterns[pattern].nameOffset;
+}
+
+int CompoundDatabase::GetPatternMaxElementCount(int pattern)
+{
+    Assert(pattern >= 0 && pattern < GetPatternCount());
+    return maxElementCounts[pattern];
+}
+
+int CompoundDatabase::GetPatternLargestFirst(int n)
+{
+    Assert(n >= 0 && n < GetPatternCount());
+    return patternsLargestFirst[n];
+}
+
+uint32 CompoundDatabase::GetPatternsFor(Element* element)
+{
+    Assert(header != NULL);
+    return patternsByRawElement[element->GetRawElementNum()];
+}
+
+uint32 CompoundDatabase::GetPossiblePatterns(const ReactionSignature* signature)
+{
+    Assert(header != NULL);
+    uint32 ret = 0;
+
+    for (int p = 0; p < header->patternCount; p++)
+    {
+        const CompoundDatabasePattern* pattern = &patterns[p];
+
+        if (signature->elementCount < pattern->minElementCount)
+        { continue; }
+
+        // Compare all of the group counts at once: Setting the high bit of each of the reaction's counts keeps the subtraction from borrowing across
+        // groups, and the high bit stays set for every group where the reaction has at least as many elements as the pattern needs.
+        if ((((signature->groupCounts | 0x88888888) - pattern->requiredGroupCounts) & 0x88888888) != 0x88888888)
+        { continue; }
+
+        bool hasSymbols = true;
+        for (int s = 0; s < pattern->requiredSymbolCount && hasSymbols; s++)
+        { hasSymbols = signature->rawElementCounts[requiredRawElements[p][s]] >= pattern->requiredAtomCounts[s]; }
+
+        if (hasSymbols)
+        { ret |= 1 << p; }
+    }
+
+    return ret;
+}
+
+bool CompoundDatabase::HasRootNeighbors(int p, const ReactionSnapshot* snapshot, int root)
+{
+    Assert(p >= 0 && p < GetPatternCount());
+    Assert(root >= 0 && root < snapshot->elementCount);
+    const CompoundDatabasePattern* pattern = &patterns[p];
+
+    if (snapshot->neighborCounts[root] < pattern->rootNeighborCount)
+    { return false; }
+
+    // Same as the group counts in GetPossiblePatterns, an element can't have more neighbors in a group than 4 bits can count.
+    if ((((snapshot->neighborGroupCounts[root] | 0x88888888) - pattern->rootNeighborGroupCounts) & 0x88888888) != 0x88888888)
+    { return false; }
+
+    for (int s = 0; s < pattern->rootNeighborSymbolCount; s++)
+    {
+        if (snapshot->CountNeighbors(snapshot->neighborAtomicNumbers[root], pattern->rootNeighborAtomicNumbers[s]) < pattern->rootNeighborAtomCounts[s])
+        { return false; }
+    }
+
+    return true;
+}
+
+void ReactionSignature::Build(ElementSet* elements)
+{
+    elementCount = elements->Count();
+    groupCounts = 0;
+    PeriodicMemset(rawElementCounts, 0, sizeof(rawElementCounts));
+
+    for (int i = 0; i < elements->Count(); i++)
+    {
+        Element* element = elements->Get(i);
+        rawElementCounts[element->GetRawElementNum()]++;
+
+        int shift = element->GetGroup() * 4;
+        if (((groupCounts >> shift) & 0xF) < 7)
+        { groupCounts += 1 << shift; }
+    }
+}
+
+uint32 CompoundDatabase::GetPatternsSharingPrefix(int pattern, int nodeCount)
+{
+    Assert(pattern >= 0 && pattern < GetPatternCount());
+    Assert(nodeCount >= 1 && nodeCount <= patterns[pattern].nodeCount);
+    return prefixes[patterns[pattern].firstNode + nodeCount - 1];
+}
+
+bool CompoundDatabase::ProcessPattern(int pattern, Reaction* reaction, ReactionSnapshot* snapshot, Compound* compound, int root, int* nodesReached)
+{
+    Assert(pattern >= 0 && pattern < GetPatternCount());
+    const ReactionNode* first = &nodes[patterns[pattern].firstNode];
+    return first->Process(first + patterns[pattern].nodeCount, reaction, snapshot, compound, root, nodesReached);
+}
@@ -0,0 +1,155 @@
+#ifndef __COMPOUNDDATABASE_H__
+#define __COMPOUNDDATABASE_H__
+
+#include "periodic.h"
+#include "ReactionNode.h"
+#include "ElementSet.h"
+
+class Compound;
+class Element;
+class Reaction;
+struct ReactionSnapshot;
+
+//! The maximum number of patterns in the compound database, limited by the width of a pattern mask.
+#define MAX_DATABASE_PATTERNS ((int)(sizeof(uint32) * 8))
+
+//------------------------------------------------------------------------------
+// Compound database image format
+//------------------------------------------------------------------------------
+// Compound database images are produced by CompoundGen from compounds.txt. They're read in place, so these structures must exactly
+// match what CompoundGen writes. All values are little-endian and every table is aligned to its record size.
+// The image is laid out as:
+// * A CompoundDatabaseHeader
+// * patternCount CompoundDatabasePatterns, starting at patternsOffset
+// * nodeCount ReactionNodes, starting at nodesOffset (Each pattern is a contiguous run of nodes.)
+// * nodeCount uint32 pattern masks, starting at prefixesOffset (One per node, see CompoundDatabase::GetPatternsSharingPrefix.)
+// * The null-terminated names of the patterns, starting at namesOffset
+#define COMPOUND_DATABASE_MAGIC "PCDB"
+#define COMPOUND_DATABASE_VERSION 6
+
+struct CompoundDatabaseHeader
+{
+    char magic[4];
+    uint8 version;
+    //! The deepest depth used by any node in the image
+    uint8 maxDepth;
+    uint16 patternCount;
+    uint16 nodeCount;
+    uint16 patternsOffset;
+    uint16 nodesOffset;
+    uint16 prefixesOffset;
+    uint16 namesOffset;
+    //! Always 0, pads the header to a multiple of 4 bytes.
+    uint16 reserved;
+    //! The total size of the image in bytes
+    uint32 size;
+};
+CompilerAssert(sizeof(CompoundDatabaseHeader) == 24);
+
+//! The number of distinct element symbols a pattern's signature can require
+#define MAX_PATTERN_REQUIRED_SYMBOLS 4
+
+//! A single compound in the compound database, described by a pattern of ReactionNodes rooted at its first node.
+//!
+//! Each pattern also has a signature of the elements a reaction must contain for the pattern to have any chance of matching, which lets
+//! Reaction::Process reject patterns without visiting any of their nodes. The signature is a lower bound, so it may accept patterns that
+//! can't match but never rejects one that can.
+//!
+//! Patterns whose root passes its input through also record what the root element needs from its own neighbors, since every node below the root
+//! that bonds to one of them needs a different neighbor. CompoundDatabase::HasRootNeighbors uses this to skip root elements the pattern can't
+//! possibly match from. (The branches of an EitherOr only require what all of them require, just like the signature.)
+struct CompoundDatabasePattern
+{
+    uint16 firstNode;
+    uint16 nodeCount;
+    //! Offset of the human-readable name of this pattern from the start of the name table, used for debugging.
+    uint16 nameOffset;
+    //! The fewest elements that can match this pattern
+    uint8 minElementCount;
+    //! The number of entries used in requiredAtomicNumbers and requiredAtomCounts
+    uint8 requiredSymbolCount;
+    //! The number of elements needed from each group, 4 bits per groupState (saturated at 7)
+    uint32 requiredGroupCounts;
+    //! The atomic numbers of the element symbols this pattern needs and how many of each it needs
+    uint8 requiredAtomicNumbers[MAX_PATTERN_REQUIRED_SYMBOLS];
+    uint8 requiredAtomCounts[MAX_PATTERN_REQUIRED_SYMBOLS];
+
+    //! The fewest neighbors the root element needs
+    uint8 rootNeighborCount;
+    //! The number of entries used in rootNeighborAtomicNumbers and rootNeighborAtomCounts
+    uint8 rootNeighborSymbolCount;
+    //! Always 0, aligns rootNeighborGroupCounts.
+    uint16 reserved;
+    //! The number of neighbors the root element needs from each group, 4 bits per groupState (saturated at 7)
+    uint32 rootNeighborGroupCounts;
+    //! The atomic numbers of the element symbols the root element needs as neighbors and how many of each it needs
+    uint8 rootNeighborAtomicNumbers[MAX_PATTERN_REQUIRED_SYMBOLS];
+    uint8 rootNeighborAtomCounts[MAX_PATTERN_REQUIRED_SYMBOLS];
+};
+CompilerAssert(sizeof(CompoundDatabasePattern) == 36);
+CompilerAssert(GROUP_COUNT * 4 <= sizeof(uint32) * 8);
+
+//! A summary of the elements in a reaction, compared against pattern signatures by CompoundDatabase::GetPossiblePatterns.
+struct ReactionSignature
+{
+    int elementCount;
+    //! The number of elements from each group, 4 bits per groupState (saturated at 7)
+    uint32 groupCounts;
+    //! The number of elements of each raw element
+    uint8 rawElementCounts[MAX_RAW_ELEMENTS];
+
+    void Build(ElementSet* elements);
+};
+
+//------------------------------------------------------------------------------
+// Compound database
+//------------------------------------------------------------------------------
+//! The compound database used by Reaction::Process.
+//! A database must be loaded before any reactions are processed.
+class CompoundDatabase
+{
+public:
+    //! Loads the compound database from a compiled image. The image is used in place, so it must remain valid until another database is loaded.
+    //! Returns false and leaves the current database alone if the image is not a valid compound database.
+    static bool Load(const void* image, uint32 size);
+    //! Loads the compound database embedded in the program. (Generated from compounds.txt)
+    static void LoadDefault();
+#ifdef STANDALONE_APP
+    //! Memory-maps a compound database image from the given file and loads it, returns false if the file could not be loaded.
+    static bool LoadFile(const char* path);
+#endif
+
+    //! Returns a hash of the current database image, used to check whether data generated from a database still applies to the current one.
+    static uint32 GetImageHash();
+    static int GetPatternCount();
+    static const char* GetPatternName(int pattern);
+    //! Returns the most elements the given pattern could ever match.
+    static int GetPatternMaxElementCount(int pattern);
+    //! Returns the Nth pattern when the patterns are ordered from the most elements they could match to the fewest. (Ties keep database order.)
+    static int GetPatternLargestFirst(int n);
+
+    //! Returns the mask of patterns whose root could accept the given element.
+    //! Bit N of the mask corresponds to pattern N, so iterating the bits in order visits patterns in database order.
+    static uint32 GetPatternsFor(Element* element);
+    //! Returns the mask of patterns whose signature fits in a reaction with the given signature.
+    //! Patterns outside of the mask can't possibly match any elements of the reaction.
+    static uint32 GetPossiblePatterns(const ReactionSignature* signature);
+    //! Returns false if the given element of the given snapshot doesn't have the neighbors the given pattern needs around its root.
+    //! The pattern can't match with the element as its root in that case, so it doesn't need to be searched.
+    static bool HasRootNeighbors(int pattern, const ReactionSnapshot* snapshot, int root);
+
+    //! Returns the mask of patterns that start with the same first nodeCount nodes as the given pattern, and can't match unless those nodes do.
+    //!
+    //! CompoundGen merges the patterns into a trie of the prefixes they share. (Nodes that only differ in their bonds are shared, since the search
+    //! doesn't look at bonds.) When a pattern fails from a root without processing any node past its first nodeCount nodes, its prefix failed on
+    //! its own, so every pattern in this mask would fail from that root too. This lets a shared prefix be searched once per root element rather
+    //! than once per pattern.
+    static uint32 GetPatternsSharingPrefix(int pattern, int nodeCount);
+
+    //! Tries to match the given pattern with the given element of the given reaction as its root, applying bonds to the compound on success.
+    //! root is the index of the element in the given snapshot of the reaction. compound may be NULL to only find out whether the pattern matches.
+    //! If nodesReached isn't NULL, it receives how many of the pattern's leading nodes the search got to. (See GetPatternsSharingPrefix.)
+    static bool ProcessPattern(int pattern, Reaction* reaction, ReactionSnapshot* snapshot, Compound* compound, int root, int* nodesReached);
+};
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef __COMPOUNDSET_H__
+#define __COMPOUNDSET_H__
+
+#include "Set.h"
+#include "periodic.h"
+
+class Compound;
+typedef Set<Compound, MAX_COMPOUNDS> CompoundSet;
+
+#endif
@@ -1,6 +1,7 @@
 #include "periodic.h"
 #include "Element.h"
 #include "Reaction.h"
+#include "Compound.h"
 #include <sifteo.h>
 
 // Default constructor will not create a valid element, it must be initialized before use using GetRawElement
@@ -22,36 +23,48 @@ Element::Element(const char* name, const char* symbol, groupState group, short a
     this->sharedElectrons = 0;
     this->numCharge = 0;
 
-    PeriodicMemset(bonds, 0, sizeof(bonds));
+    PeriodicMemset(neighbors, 0, sizeof(neighbors));
     this->currentReaction = NULL;
     this->currentCompound = NULL;
-    ClearMask();
+    this->hasReactionState = true; // Raw elements never change, so their reaction state is always their basic state.
 }
 
 void Element::ChangeInto(Element* baseElement)
 {
     Assert(baseElement != NULL);
     this->baseElement = baseElement;
-    ResetToBasicState();
-}
 
-/*Resets an element that has already changed to its original state.  */
-void Element::ResetToBasicState()
-{
+    // Only the reaction state ever changes, so these are only copied here:
     this->name = baseElement->name;
     this->symbol = baseElement->symbol;
     this->group = baseElement->group;
     this->atomicNumber = baseElement->atomicNumber;
     this->elementWeight = baseElement->elementWeight;
-    this->numOuterElectrons = baseElement->numOuterElectrons;
     this->electroNegativity = baseElement->electroNegativity;
+    ResetToBasicState();
+}
+
+/*Resets an element that has already changed to its original state.  */
+void Element::ResetToBasicState()
+{
+    // The reaction state is put back into its basic state the next time it's changed, until then it reads as the basic state.
+    this->hasReactionState = false;
+}
+
+void Element::TouchReactionState()
+{
+    if (hasReactionState)
+    { return; }
+
+    Assert(!IsRawElement());
+    this->numOuterElectrons = baseElement->numOuterElectrons;
     this->sharedElectrons = 0;
     this->numCharge = 0;
 
-    PeriodicMemset(bonds, 0, sizeof(bonds));
+    PeriodicMemset(neighbors, 0, sizeof(neighbors));
     this->currentReaction = NULL;
     this->currentCompound = NULL;
-    ClearMask();
+    this->hasReactionState = true;
 }
 
 //Getters
@@ -60,9 +73,9 @@ const char* Element::GetSymbol() { return symbol; }
 groupState Element::GetGroup() { return group; }
 short Element::GetAtomicNumber() { return atomicNumber; }
 double Element::GetElementWeight() { return elementWeight; }
-int Element::GetNumOuterElectrons() { return numOuterElectrons; }
+int Element::GetNumOuterElectrons() { return hasReactionState ? numOuterElectrons : baseElement->numOuterElectrons; }
 double Element::GetElectroNegativity() { return electroNegativity; }
-int Element::GetSharedElectrons() { return sharedElectrons; }
+int Element::GetSharedElectrons() { return hasReactionState ? sharedElectrons : 0; }
 
 /*Returns if the element is in its base state or not. */
 bool Element::IsRawElement()
@@ -80,7 +93,7 @@ int Element::GetCharge()
 
     return baseElement->numOuterElectrons - this->numOuterElectrons;
     */
-    return numCharge;
+    return hasReactionState ? numCharge : 0;
 }
 
 
@@ -127,6 +140,7 @@ static Element rawElements[] =
 	//Metaloids
 	Element("Silicon", "Si", METALOID, 14, 28.085, 4, 1.90)
 };
+CompilerAssert(CountOfArray(rawElements) <= MAX_RAW_ELEMENTS);
 
 void Element::GetRawElement(int num, Element* elementOut)
 {
@@ -145,17 +159,69 @@ bool Element::GetRawElement(const char* name, Element* elementOut)
     return true;
 }
 
-int Element::GetRawElementNum(const char* name)
+//! The number of slots in the symbol hash table, a sparse table makes it easy to find a multiplier that gives every symbol its own slot.
+#define SYMBOL_HASH_SIZE (MAX_RAW_ELEMENTS * 4)
+#define SYMBOL_HASH_SHIFT 25 // 32 - log2(SYMBOL_HASH_SIZE)
+#define SYMBOL_HASH_EMPTY 0xFF
+//! The multiplier of the perfect hash of the raw element symbols, see rawElementsBySymbolHash.
+#define SYMBOL_HASH_MULTIPLIER 0x535B886Du
+CompilerAssert((1 << (32 - SYMBOL_HASH_SHIFT)) == SYMBOL_HASH_SIZE);
+CompilerAssert(MAX_RAW_ELEMENTS < SYMBOL_HASH_EMPTY);
+
+//! The raw element number for each slot of the symbol hash table, or SYMBOL_HASH_EMPTY.
+//! This must be updated along with rawElements, Element::CheckSymbolHash catches a stale table at startup. Any multiplier that gives every
+//! symbol its own slot will do, the current one is the first one found by stepping an LCG from the golden ratio.
+static const uint8 rawElementsBySymbolHash[SYMBOL_HASH_SIZE] =
+{
+    0xFF, 0xFF, 0xFF, 0x19, 0xFF, 0xFF, 0x18, 0xFF, 0xFF, 0xFF, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0B, 0x14, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x0E, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0x16, 0xFF, 0xFF, 0x03, 0xFF, 0x0D, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x09,
+    0xFF, 0x12, 0xFF, 0xFF, 0xFF, 0xFF, 0x06, 0x11, 0x1A, 0xFF, 0xFF, 0xFF, 0xFF, 0x07, 0xFF, 0xFF,
+    0xFF, 0xFF, 0x10, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x17, 0xFF, 0x04, 0xFF,
+    0xFF, 0xFF, 0x0F, 0xFF, 0x0A, 0x0C, 0xFF, 0xFF, 0x15, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x08, 0xFF, 0xFF, 0x13, 0x05, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+//! Packs a symbol of up to two characters into an integer, returns 0 if the symbol is longer than that.
+static uint32 PackSymbol(const char* symbol)
+{
+    if (symbol[0] == '\0')
+    { return 0; }
+    if (symbol[1] == '\0')
+    { return (uint8)symbol[0]; }
+    if (symbol[2] == '\0')
+    { return (uint8)symbol[0] | ((uint8)symbol[1] << 8); }
+    return 0;
+}
+
+static int HashSymbol(uint32 packedSymbol)
+{
+    return (packedSymbol * SYMBOL_HASH_MULTIPLIER) >> SYMBOL_HASH_SHIFT;
+}
+
+void Element::CheckSymbolHash()
 {
     for (int i = 0; i < GetRawElementCount(); i++)
     {
-        if (strcmp(name, rawElements[i].GetSymbol()) == 0)
-        {
-            return i;
-        }
+        uint32 packedSymbol = PackSymbol(rawElements[i].GetSymbol());
+        Assert(packedSymbol != 0); // Raw element symbols must be one or two characters.
+        Assert(rawElementsBySymbolHash[HashSymbol(packedSymbol)] == i); // The symbol hash table is out of date.
     }
+}
+
+int Element::GetRawElementNum(const char* name)
+{
+    uint32 packedSymbol = PackSymbol(name);
+    if (packedSymbol == 0)
+    { return -1; }
+
+    // Every raw element has its own slot, so the slot either holds the element with this symbol or this symbol isn't a raw element.
+    int num = rawElementsBySymbolHash[HashSymbol(packedSymbol)];
+    if (num == SYMBOL_HASH_EMPTY || PackSymbol(rawElements[num].GetSymbol()) != packedSymbol)
+    { return -1; }
 
-    return -1;
+    return num;
 }
 
 int Element::GetRawElementCount()
@@ -163,16 +229,23 @@ int Element::GetRawElementCount()
     return CountOfArray(rawElements);
 }
 
+int Element::GetRawElementNum()
+{
+    Assert(!IsRawElement());
+    return baseElement - rawElements;
+}
+
 void Element::AddBond(BondSide side, Element* with)
 {
     Assert(!IsRawElement());
-    
-    if (bonds[side].GetElement() == with)
+    TouchReactionState();
+
+    if (neighbors[side] == with)
     { return; }
 
     //LOG("Element:0x%X[%s].AddBond(side=%d, with=Element:0x%X[%s])\n", this, symbol, side, with, with->symbol);
-    Assert(bonds[side].GetElement() == NULL);
-    bonds[side] = Bond(side, with);
+    Assert(neighbors[side] == NULL);
+    neighbors[side] = with;
 
     // Add the bonded element to our reaction
     Assert(currentReaction != NULL);
@@ -185,6 +258,7 @@ void Element::AddBond(BondSide side, Element* with)
 void Element::SetReaction(Reaction* reaction)
 {
     Assert(!IsRawElement());
+    TouchReactionState();
 
     if (currentReaction == reaction)
     { return; }
@@ -197,13 +271,13 @@ void Element::SetReaction(Reaction* reaction)
 BondType Element::GetBondTypeFor(Compound* compound, BondSide side)
 {
     Assert(side >= 0 && side < BondSide_Count);
-    return bonds[side].GetTypeFor(compound);
+    return compound == NULL ? BondType_None : compound->GetBondType(this, side);
 }
 
 int Element::GetBondDataFor(Compound* compound, BondSide side)
 {
     Assert(side >= 0 && side < BondSide_Count);
-    return bonds[side].GetDataFor(compound);
+    return compound == NULL ? 0 : compound->GetBondData(this, side);
 }
 
 void Element::SetBondTypeFor(Compound* compound, BondSide side, BondType type, int data, int otherData)
@@ -215,14 +289,13 @@ void Element::SetBondTypeFor(Compound* compound, BondSide side, BondType type, i
     Assert(type >= 0 && type < BondType_Count);
 
     // Don't apply the bond if we already did it
-    if (bonds[side].GetTypeFor(compound) == type && bonds[side].GetDataFor(compound) == data)
+    if (GetBondTypeFor(compound, side) == type && GetBondDataFor(compound, side) == data)
     { return; }
 
-    // Set the type, and set the inverse type
-    compound->AddElement(this); // Add ourselves if we weren't already part of this compound.
-    bonds[side].SetTypeFor(compound, type, data);
+    // Set the type, and set the inverse type (This adds us to the compound if we weren't already part of it.)
+    compound->SetBond(this, side, type, data);
 
-    bonds[side].GetElement()->SetBondTypeFor(compound, Bond::GetOppositeSide(side), type, otherData, data);
+    GetBondWith(side)->SetBondTypeFor(compound, Bond::GetOppositeSide(side), type, otherData, data);
 }
 
 void Element::SetBondTypeFor(Compound* compound, Element* otherElement, BondType type, int data, int otherData)
@@ -241,25 +314,26 @@ void Element::SetBondTypeFor(Compound* compound, Element* otherElement, BondType
 void Element::SetBondTypeFor(Compound* compound, Element* otherElement, BondType type)
 { SetBondTypeFor(compound, otherElement, type, 0, 0); }
 
-void Element::PurgeBondInfo(Compound* compound)
+void Element::SetOneSidedBondTypeFor(Compound* compound, BondSide side, BondType type, int data)
 {
-    for (int i = 0; i < BondSide_Count; i++)
-    { bonds[i].PurgeInfoFor(compound); }
+    Assert(side >= 0 && side < BondSide_Count);
+    Assert(type >= 0 && type < BondType_Count);
+    Assert(GetBondWith(side) != NULL);
+
+    compound->SetBond(this, side, type, data);
 }
 
 BondType Element::GetBondTypeFor(BondSide side)
 {
-    Assert(side >= 0 && side < BondSide_Count);
-    return bonds[side].GetTypeFor(currentCompound);
+    return GetBondTypeFor(hasReactionState ? currentCompound : NULL, side);
 }
 
 int Element::GetBondDataFor(BondSide side)
 {
-    Assert(side >= 0 && side < BondSide_Count);
-    return bonds[side].GetDataFor(currentCompound);
+    return GetBondDataFor(hasReactionState ? currentCompound : NULL, side);
 }
 
-bool Element::HasBondType(BondType type, unsigned int maskFilter)
+bool Element::HasBondType(BondType type)
 {
     for (int i = 0; i < BondSide_Count; i++)
     {
@@ -273,15 +347,15 @@ bool Element::HasBondType(BondType type, unsigned int maskFilter)
 Element* Element::GetBondWith(BondSide side)
 {
     Assert(side >= 0 && side < BondSide_Count);
-    return bonds[side].GetElement();
+    return hasReactionState ? neighbors[side] : NULL;
 }
 
-Element* Element::GetBondWith(groupState group, unsigned int maskFilter)
+Element* Element::GetBondWith(groupState group)
 {
     for (int i = 0; i < BondSide_Count; i++)
     {
         Element* ret = GetBondWith((BondSide)i);
-        if (ret != NULL && ret->GetGroup() == group && !ret->MatchesMask(maskFilter))
+        if (ret != NULL && ret->GetGroup() == group)
         {
             return ret;
         }
@@ -290,12 +364,21 @@ Element* Element::GetBondWith(groupState group, unsigned int maskFilter)
     return NULL;
 }
 
-Element* Element::GetBondWith(const char* symbol, unsigned int maskFilter)
+Element* Element::GetBondWith(const char* symbol)
+{
+    int num = GetRawElementNum(symbol);
+    if (num < 0)
+    { return NULL; }
+
+    return GetBondWithAtomicNumber(rawElements[num].GetAtomicNumber());
+}
+
+Element* Element::GetBondWithAtomicNumber(short atomicNumber)
 {
     for (int i = 0; i < BondSide_Count; i++)
     {
         Element* ret = GetBondWith((BondSide)i);
-        if (ret != NULL && strcmp(ret->GetSymbol(), symbol) == 0 && !ret->MatchesMask(maskFilter))
+        if (ret != NULL && ret->atomicNumber == atomicNumber)
         {
             return ret;
         }
@@ -304,13 +387,13 @@ Element* Element::GetBondWith(const char* symbol, unsigned int maskFilter)
     return NULL;
 }
 
-ElementSet* Element::GetBondsWith(groupState group, unsigned int maskFilter)
+ElementSet* Element::GetBondsWith(groupState group)
 {
     ElementSet* ret = new ElementSet();
     for (int i = 0; i < BondSide_Count; i++)
     {
         Element* other = GetBondWith((BondSide)i);
-        if (other != NULL && other->GetGroup() == group && !other->MatchesMask(maskFilter))
+        if (other != NULL && other->GetGroup() == group)
         {
             ret->Add(other);
         }
@@ -320,17 +403,17 @@ ElementSet* Element::GetBondsWith(groupState group, unsigned int maskFilter)
 }
 
 bool Element::GetBondWith(BondSide side, Element** element_out) { *element_out = GetBondWith(side); return !!*element_out; }
-bool Element::GetBondWith(groupState group, Element** element_out, unsigned int maskFilter) { *element_out = GetBondWith(group, maskFilter); return !!*element_out; }
-bool Element::GetBondWith(const char* symbol, Element** element_out, unsigned int maskFilter) { *element_out = GetBondWith(symbol, maskFilter); return !!*element_out; }
+bool Element::GetBondWith(groupState group, Element** element_out) { *element_out = GetBondWith(group); return !!*element_out; }
+bool Element::GetBondWith(const char* symbol, Element** element_out) { *element_out = GetBondWith(symbol); return !!*element_out; }
 
-bool Element::HasBondWith(groupState group, unsigned int maskFilter)
+bool Element::HasBondWith(groupState group)
 {
-    return GetBondWith(group, maskFilter) != NULL;
+    return GetBondWith(group) != NULL;
 }
 
-bool Element::HasBondWith(const char* symbol, unsigned int maskFilter)
+bool Element::HasBondWith(const char* symbol)
 {
-    return GetBondWith(symbol, maskFilter) != NULL;
+    return GetBondWith(symbol) != NULL;
 }
 
 BondSide Element::SideOf(Element* otherElement)
@@ -346,38 +429,9 @@ BondSide Element::SideOf(Element* otherElement)
     return BondSide_Invalid;
 }
 
-void Element::SetMaskBit(int bit)
-{
-    Assert(bit >= 0 && bit < (sizeof(mask) * 8));
-    this->mask |= (1 << bit);
-}
-
-void Element::ClearMaskBit(int bit)
-{
-    Assert(bit >= 0 && bit < (sizeof(mask) * 8));
-    this->mask &= ~(1 << bit);
-}
-
-void Element::SetMaskBit(int bit, bool value)
-{
-    if (value)
-    { SetMaskBit(bit); }
-    else
-    { ClearMaskBit(bit); }
-}
-
-void Element::ClearMask()
-{
-    this->mask = 0;
-}
-
-bool Element::MatchesMask(unsigned int maskFilter)
-{
-    return !!(this->mask & maskFilter);
-}
-
 void Element::ApplyCompound(Compound* compound)
 {
+    TouchReactionState();
     Assert(currentCompound == NULL);
     Assert(compound != NULL);
     
@@ -401,7 +455,7 @@ void Element::ApplyCompound(Compound* compound)
         else if (type == BondType_Ionic)
         {
             //In Ionic Reaction "H" only gets electrons
-            if (strcmp(this->GetSymbol(), "H") == 0)
+            if (this->atomicNumber == ATOMIC_NUMBER_HYDROGEN)
             {
                 this->numOuterElectrons = 2;
                 this->numCharge = this->baseElement->numOuterElectrons - 2;
@@ -2,20 +2,23 @@
 #define __ELEMENT_H__
 
 #include "Bond.h"
-#include "BondSolution.h"
 #include "ElementSet.h"
 
 class Reaction;
 class Compound;
 
 /*Enumeration to keep track of the group a element belongs in */
-enum groupState {ALKALI, ALKALIEARTH, HALOGEN, NOBLE, HYDROGEN, NONMETAL, METALOID };
+enum groupState {ALKALI, ALKALIEARTH, HALOGEN, NOBLE, HYDROGEN, NONMETAL, METALOID, GROUP_COUNT /* Not a group, the number of groups */ };
 
 /**/
 
 enum bondState { IONIC, COVALENT, POTENTIAL, NONE };
 
-#define ALL_ELEMENTS_MASK 0xFFFFFFFF
+//! The maximum number of raw elements the program can know about, used for sizing tables indexed by raw element number.
+#define MAX_RAW_ELEMENTS 32
+
+//! The atomic number of hydrogen, which gets special treatment in a few places.
+#define ATOMIC_NUMBER_HYDROGEN 1
 
 //! Element represents a chemical element
 class Element
@@ -34,24 +37,28 @@ class Element
         short atomicNumber;
         //! The atomic weight of this element
         double elementWeight;
-        //! The number of outer electrons for this element
-        int numOuterElectrons;
         //! The electronegativity for this element
 		double electroNegativity;
+
+        //! False once this element has been reset, until something changes its reaction state again.
+        //! The reaction state is every field below this one, and it reads as the basic state while this is false. (See TouchReactionState.)
+        bool hasReactionState;
+        //! The number of outer electrons for this element
+        int numOuterElectrons;
         //! The number of electrons this element is sharing with neighboring elements.
         int sharedElectrons;
         //! The number of charge for this element 
         int numCharge;
 
-        //! Bitmask of categories associated with this Element
-        uint32 mask;
-
-        Bond bonds[BondSide_Count];
+        //! The element on each side of this element, or NULL. (The type of each bond is recorded by the compounds that use it.)
+        Element* neighbors[BondSide_Count];
         Reaction* currentReaction;
         Compound* currentCompound;
 
         //! Changes this element into the basic state of another element
         void ChangeInto(Element* newBaseElement);
+        //! Puts the reaction state of this element into its basic state if it was reset, must be called before changing the reaction state.
+        void TouchReactionState();
     public:
         //! Creates a dead element, elements made with this constructor must be initialized with one of the static pseudoconstructors before use.
         Element();
@@ -85,12 +92,17 @@ class Element
         static void GetRawElement(int num, Element* elementOut);
         //! Pseudoconstructor for initializing the specified Element with the Element with the given symbol on the periodic table
         static bool GetRawElement(const char* name, Element* elementOut);
-        //! Utility function for getting the index of the natural Element with the  given symbol on the periodic table
+        //! Utility function for getting the index of the natural Element with the  given symbol on the periodic table, -1 if there isn't one.
+        //! This is a constant-time perfect hash lookup, so it's also how symbols are interned everywhere else.
         static int GetRawElementNum(const char* name);
+        //! Asserts that the precomputed symbol hash used by GetRawElementNum gives every raw element its own slot, called once at startup.
+        static void CheckSymbolHash();
         //! Returns the number of raw elements in their natural state that this program knows about
         static int GetRawElementCount();
+        //! Returns the index of the natural Element this element is derived from
+        int GetRawElementNum();
 
-        //! Resets this element to its natural state
+        //! Resets this element to its natural state, this doesn't touch the reaction state so it takes constant time.
         void ResetToBasicState();
 
         //! Reacts this element with another one
@@ -109,35 +121,30 @@ class Element
         void SetBondTypeFor(Compound* compound, Element* otherElement, BondType type, int data, int otherData);
         void SetBondTypeFor(Compound* compound, Element* otherElement, BondType type, int data);
         void SetBondTypeFor(Compound* compound, Element* otherElement, BondType type);
-
-        void PurgeBondInfo(Compound* compound);
+        //! Sets the bond type for one side without updating the element on the other side, used for restoring bonds recorded by a ReactionOutcome.
+        void SetOneSidedBondTypeFor(Compound* compound, BondSide side, BondType type, int data);
 
         BondType GetBondTypeFor(BondSide side);
         int GetBondDataFor(BondSide side);
 
-        bool HasBondType(BondType type, uint32 maskFilter = ALL_ELEMENTS_MASK);
+        bool HasBondType(BondType type);
 
         Element* GetBondWith(BondSide side);
-        Element* GetBondWith(groupState group, uint32 maskFilter = ALL_ELEMENTS_MASK);
-        Element* GetBondWith(const char* symbol, uint32 maskFilter = ALL_ELEMENTS_MASK);
+        Element* GetBondWith(groupState group);
+        Element* GetBondWith(const char* symbol);
+        Element* GetBondWithAtomicNumber(short atomicNumber);
 
-        ElementSet* GetBondsWith(groupState group, uint32 maskFilter = ALL_ELEMENTS_MASK);
+        ElementSet* GetBondsWith(groupState group);
 
         bool GetBondWith(BondSide side, Element** element_out);
-        bool GetBondWith(groupState group, Element** element_out, uint32 maskFilter = ALL_ELEMENTS_MASK);
-        bool GetBondWith(const char* symbol, Element** element_out, uint32 maskFilter = ALL_ELEMENTS_MASK);
+        bool GetBondWith(groupState group, Element** element_out);
+        bool GetBondWith(const char* symbol, Element** element_out);
 
-        bool HasBondWith(groupState group, uint32 maskFilter = ALL_ELEMENTS_MASK);
-        bool HasBondWith(const char* symbol, uint32 maskFilter = ALL_ELEMENTS_MASK);
+        bool HasBondWith(groupState group);
+        bool HasBondWith(const char* symbol);
 
         BondSide SideOf(Element* otherElement);
 
-        void SetMaskBit(int bit);
-        void ClearMaskBit(int bit);
-        void SetMaskBit(int bit, bool value);
-        void ClearMask();
-        bool MatchesMask(unsigned int maskFilter);
-
         void ApplyCompound(Compound* compound);
 };
 
@@ -390,7 +390,7 @@ void ElementCube::DrawLewisDots(int stringWidth, int stringHeight)
 		return;
 	}
     //special case for "H"
-    if (currentElement.GetCharge() != 0 && strcmp(currentElement.GetSymbol(), "H") == 0 && currentElement.GetNumOuterElectrons() == 2)
+    if (currentElement.GetCharge() != 0 && currentElement.GetAtomicNumber() == ATOMIC_NUMBER_HYDROGEN && currentElement.GetNumOuterElectrons() == 2)
     {
         return;
     }
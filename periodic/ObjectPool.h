@@ -10,6 +10,10 @@ class ObjectPool
 private:
     static PoolT objectPool[PoolSizeT];
     static int numUninitialized;
+#ifdef STANDALONE_APP
+    //! Reactions allocate compounds from worker threads in the standalone app
+    static Sifteo::__lock poolLock;
+#endif
 
     bool inUse;
 public:
@@ -28,12 +32,15 @@ public:
         Assert(size == sizeof(PoolT)); // Something has gone very wrong
 
         // Look for a free object in the pool and return it
+        PeriodicLock(poolLock);
         for (int i = 0; i < PoolSizeT; i++)
         {
             if (objectPool[i].inUse) { continue; }
             objectPool[i].inUse = true;
+            PeriodicUnlock(poolLock);
             return &objectPool[i];
         }
+        PeriodicUnlock(poolLock);
 
         // If we get this far, we've exhausted the object pool
         LOG("FATAL: Object pool with %d elements exhausted!\n", PoolSizeT);
@@ -46,7 +53,9 @@ public:
         if (p == NULL)
         { return; }
 
+        PeriodicLock(poolLock);
         ((PoolT*)p)->inUse = false;
+        PeriodicUnlock(poolLock);
     }
 };
 
@@ -56,4 +65,9 @@ PoolT ObjectPool<PoolT, PoolSizeT>::objectPool[PoolSizeT]; // Note: Be aware tha
 template<class PoolT, int PoolSizeT>
 int ObjectPool<PoolT, PoolSizeT>::numUninitialized = PoolSizeT;
 
+#ifdef STANDALONE_APP
+template<class PoolT, int PoolSizeT>
+Sifteo::__lock ObjectPool<PoolT, PoolSizeT>::poolLock; // Zero-initialized, which is unlocked.
+#endif
+
 #endif
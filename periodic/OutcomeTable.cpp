@@ -0,0 +1,328 @@
+#include "OutcomeTable.h"
+#include "CompoundDatabase.h"
+#include "Element.h"
+#include "Reaction.h"
+
+#include <sifteo.h>
+
+//------------------------------------------------------------------------------
+// Current table
+//------------------------------------------------------------------------------
+static const OutcomeTableHeader* header = NULL;
+static const OutcomeTableEntry* entries = NULL;
+
+#ifdef STANDALONE_APP
+//! The image mapped by LoadFile, if it is the current table.
+static const void* mappedImage = NULL;
+
+static void UnmapImage()
+{
+    if (mappedImage != NULL)
+    {
+        Sifteo::__unmap_file(mappedImage);
+        mappedImage = NULL;
+    }
+}
+#endif
+
+//! Compares two table keys, returns a negative number if a comes before b, a positive number if it comes after it, and 0 if they are equal.
+static int CompareKeys(const uint8* a, const uint8* b)
+{
+    for (int i = 0; i < OUTCOME_TABLE_KEY_SIZE; i++)
+    {
+        if (a[i] != b[i])
+        { return (int)a[i] - (int)b[i]; }
+    }
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Loading
+//------------------------------------------------------------------------------
+static bool InvalidImage(const char* reason)
+{
+    LOG("Outcome table image is invalid: %s\n", reason);
+    return false;
+}
+
+//! Checks a single entry of an outcome table image, so that restoring it can't produce compounds the engine can't handle.
+static bool ValidateEntry(const OutcomeTableEntry* entry)
+{
+    if (entry->compoundCount > MAX_OUTCOME_TABLE_ELEMENTS)
+    { return InvalidImage("Entry has too many compounds."); }
+
+    for (int i = 0; i < MAX_OUTCOME_TABLE_ELEMENTS; i++)
+    {
+        if (entry->compoundOf[i] != REACTION_OUTCOME_NO_COMPOUND && entry->compoundOf[i] >= entry->compoundCount)
+        { return InvalidImage("Entry has an element in a compound that doesn't exist."); }
+
+        for (int side = 0; side < BondSide_Count; side++)
+        {
+            if (entry->bondTypes[i][side] >= BondType_Count)
+            { return InvalidImage("Entry has an invalid bond type."); }
+        }
+    }
+
+    return true;
+}
+
+bool OutcomeTable::Load(const void* image, uint32 size)
+{
+    const uint8* bytes = (const uint8*)image;
+    const OutcomeTableHeader* newHeader = (const OutcomeTableHeader*)image;
+
+    // Validate the header:
+    if (image == NULL || ((size_t)image & 3) != 0)
+    { return InvalidImage("Image is not aligned."); }
+
+    if (size < sizeof(OutcomeTableHeader))
+    { return InvalidImage("Image is truncated."); }
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (newHeader->magic[i] != OUTCOME_TABLE_MAGIC[i])
+        { return InvalidImage("Image is not an outcome table."); }
+    }
+
+    if (newHeader->version != OUTCOME_TABLE_VERSION)
+    { return InvalidImage("Image was generated for a different version of the game."); }
+
+    if (newHeader->maxElementCount > MAX_OUTCOME_TABLE_ELEMENTS)
+    { return InvalidImage("Image exceeds the limits of this version of the game."); }
+
+    if (newHeader->entriesOffset < sizeof(OutcomeTableHeader) || (newHeader->entriesOffset % sizeof(uint32)) != 0
+        || newHeader->entryCount > (size - newHeader->entriesOffset) / sizeof(OutcomeTableEntry))
+    { return InvalidImage("Entry table is out of bounds."); }
+
+    // Validate the entries, they must be sorted for Lookup to find them:
+    const OutcomeTableEntry* newEntries = (const OutcomeTableEntry*)(bytes + newHeader->entriesOffset);
+    for (uint32 i = 0; i < newHeader->entryCount; i++)
+    {
+        if (i > 0 && CompareKeys(newEntries[i - 1].key, newEntries[i].key) >= 0)
+        { return InvalidImage("Entries are not sorted."); }
+
+        if (!ValidateEntry(&newEntries[i]))
+        { return false; }
+    }
+
+    // The image is good, so it becomes the current table:
+    header = newHeader;
+    entries = newEntries;
+
+    LOG("Loaded outcome table with %d entries for up to %d elements.\n", header->entryCount, header->maxElementCount);
+    if (header->databaseHash != CompoundDatabase::GetImageHash())
+    { LOG("The outcome table was generated from a different compound database, it won't be used until that database is loaded.\n"); }
+
+    return true;
+}
+
+void OutcomeTable::Unload()
+{
+    header = NULL;
+    entries = NULL;
+
+#ifdef STANDALONE_APP
+    UnmapImage();
+#endif
+}
+
+#ifdef STANDALONE_APP
+bool OutcomeTable::LoadFile(const char* path)
+{
+    unsigned int size;
+    const void* image = Sifteo::__map_file(path, &size);
+
+    if (image == NULL)
+    {
+        LOG("Could not map outcome table '%s'.\n", path);
+        return false;
+    }
+
+    if (!Load(image, size))
+    {
+        Sifteo::__unmap_file(image);
+        return false;
+    }
+
+    // The previous image is no longer in use now that the new one has been loaded.
+    UnmapImage();
+    mappedImage = image;
+    return true;
+}
+#endif
+
+bool OutcomeTable::IsLoaded()
+{
+    return header != NULL;
+}
+
+//------------------------------------------------------------------------------
+// Queries
+//------------------------------------------------------------------------------
+bool OutcomeTable::Lookup(ElementSet* elements, CompoundSet* idealCompoundsOut)
+{
+    if (header == NULL || elements->Count() > header->maxElementCount || header->databaseHash != CompoundDatabase::GetImageHash())
+    { return false; }
+
+    ReactionKey key;
+    key.Build(elements);
+
+    uint8 tableKey[OUTCOME_TABLE_KEY_SIZE];
+    PeriodicMemset(tableKey, REACTION_KEY_NO_NEIGHBOR, sizeof(tableKey));
+    for (int i = 0; i < key.GetSize(); i++)
+    { tableKey[i] = key.data[i]; }
+
+    // Binary search for the layout, if it isn't in the table it doesn't form any compounds:
+    uint32 low = 0;
+    uint32 high = header->entryCount;
+    while (low < high)
+    {
+        uint32 middle = low + (high - low) / 2;
+        const OutcomeTableEntry* entry = &entries[middle];
+        int comparison = CompareKeys(entry->key, tableKey);
+
+        if (comparison == 0)
+        {
+            ReactionOutcome::Restore(elements, entry->compoundCount, entry->compoundOf, entry->bondTypes, entry->bondData, idealCompoundsOut);
+            break;
+        }
+
+        if (comparison < 0)
+        { low = middle + 1; }
+        else
+        { high = middle; }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Generation
+//------------------------------------------------------------------------------
+bool OutcomeTable::BuildEntry(const uint8* key, OutcomeTableEntry* entryOut)
+{
+    Assert(header == NULL); // The reaction must be searched rather than looked up in a table.
+
+    PeriodicMemset(entryOut, 0, sizeof(*entryOut));
+    for (int i = 0; i < OUTCOME_TABLE_KEY_SIZE; i++)
+    { entryOut->key[i] = key[i]; }
+
+    // Count the elements, the rest of the key must be padding:
+    int elementCount = 0;
+    while (elementCount < MAX_OUTCOME_TABLE_ELEMENTS && key[elementCount * REACTION_KEY_BYTES_PER_ELEMENT] != REACTION_KEY_NO_NEIGHBOR)
+    { elementCount++; }
+
+    if (elementCount < 2)
+    { return false; }
+
+    for (int i = elementCount * REACTION_KEY_BYTES_PER_ELEMENT; i < OUTCOME_TABLE_KEY_SIZE; i++)
+    {
+        if (key[i] != REACTION_KEY_NO_NEIGHBOR)
+        { return false; }
+    }
+
+    // Every bond must be listed by both of its elements:
+    for (int i = 0; i < elementCount; i++)
+    {
+        const uint8* neighbors = &key[i * REACTION_KEY_BYTES_PER_ELEMENT + 1];
+        for (int side = 0; side < BondSide_Count; side++)
+        {
+            int neighbor = neighbors[side];
+            if (neighbor == REACTION_KEY_NO_NEIGHBOR)
+            { continue; }
+
+            if (neighbor >= elementCount || neighbor == i)
+            { return false; }
+
+            if (key[neighbor * REACTION_KEY_BYTES_PER_ELEMENT + 1 + Bond::GetOppositeSide((BondSide)side)] != i)
+            { return false; }
+        }
+    }
+
+    Element elements[MAX_OUTCOME_TABLE_ELEMENTS];
+    for (int i = 0; i < elementCount; i++)
+    {
+        if (key[i * REACTION_KEY_BYTES_PER_ELEMENT] >= Element::GetRawElementCount())
+        { return false; }
+
+        Element::GetRawElement(key[i * REACTION_KEY_BYTES_PER_ELEMENT], &elements[i]);
+    }
+
+    // Bond each element to the first element before it that lists it as a neighbor, so that the elements join the reaction in key order:
+    Reaction reaction;
+    reaction.Add(&elements[0]);
+    for (int j = 1; j < elementCount; j++)
+    {
+        bool joined = false;
+        for (int i = 0; i < j && !joined; i++)
+        {
+            for (int side = 0; side < BondSide_Count && !joined; side++)
+            {
+                if (key[i * REACTION_KEY_BYTES_PER_ELEMENT + 1 + side] == j)
+                {
+                    elements[i].AddBond((BondSide)side, &elements[j]);
+                    joined = true;
+                }
+            }
+        }
+
+        // Elements always join a reaction through an element that joined before them.
+        if (!joined)
+        { return false; }
+    }
+
+    // Add the remaining bonds between elements that are already in the reaction:
+    for (int i = 0; i < elementCount; i++)
+    {
+        for (int side = 0; side < BondSide_Count; side++)
+        {
+            int neighbor = key[i * REACTION_KEY_BYTES_PER_ELEMENT + 1 + side];
+            if (neighbor != REACTION_KEY_NO_NEIGHBOR)
+            { elements[i].AddBond((BondSide)side, &elements[neighbor]); }
+        }
+    }
+
+    ReactionKey builtKey;
+    builtKey.Build(reaction.GetElements());
+    Assert(builtKey.GetSize() == elementCount * REACTION_KEY_BYTES_PER_ELEMENT);
+    for (int i = 0; i < builtKey.GetSize(); i++)
+    { Assert(builtKey.data[i] == key[i]); }
+
+    reaction.Evaluate();
+    entryOut->compoundCount = (uint8)ReactionOutcome::Save(reaction.GetElements(), reaction.GetIdealCompounds(), entryOut->compoundOf, entryOut->bondTypes,
+        entryOut->bondData);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Standalone app interface
+//------------------------------------------------------------------------------
+// Used by OutcomeGen to generate outcome tables with the reaction search of this build of the game.
+#ifdef STANDALONE_APP
+PeriodicExport bool LoadCompoundDatabase(const char* path)
+{
+    return CompoundDatabase::LoadFile(path);
+}
+
+PeriodicExport uint32 GetCompoundDatabaseHash()
+{
+    return CompoundDatabase::GetImageHash();
+}
+
+PeriodicExport int GetRawElementCount()
+{
+    return Element::GetRawElementCount();
+}
+
+//! Returns how many entries can be built at the same time, which is limited by the number of compounds that can exist at once.
+PeriodicExport int GetMaxConcurrentOutcomes()
+{
+    return MAX_REACTIONS;
+}
+
+PeriodicExport bool BuildOutcomeTableEntry(const uint8* key, OutcomeTableEntry* entryOut)
+{
+    return OutcomeTable::BuildEntry(key, entryOut);
+}
+#endif
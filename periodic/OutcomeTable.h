@@ -0,0 +1,84 @@
+#ifndef __OUTCOMETABLE_H__
+#define __OUTCOMETABLE_H__
+
+#include "periodic.h"
+#include "ElementSet.h"
+#include "CompoundSet.h"
+#include "ReactionOutcome.h"
+
+//------------------------------------------------------------------------------
+// Outcome table image format
+//------------------------------------------------------------------------------
+// Outcome tables are produced ahead of time by OutcomeGen, which runs the reaction search on every layout of a few elements. They're read in place,
+// so these structures must exactly match what OutcomeGen writes. All values are little-endian.
+// The image is laid out as:
+// * An OutcomeTableHeader
+// * entryCount OutcomeTableEntries, starting at entriesOffset and sorted by their key
+#define OUTCOME_TABLE_MAGIC "POTB"
+#define OUTCOME_TABLE_VERSION 1
+
+//! The most elements an outcome table can cover.
+//! The number of layouts grows very quickly with the number of elements, with four elements the table would already take hundreds of megabytes.
+#define MAX_OUTCOME_TABLE_ELEMENTS 3
+//! The size of the keys in an outcome table
+#define OUTCOME_TABLE_KEY_SIZE (MAX_OUTCOME_TABLE_ELEMENTS * REACTION_KEY_BYTES_PER_ELEMENT)
+
+struct OutcomeTableHeader
+{
+    char magic[4];
+    uint8 version;
+    //! The table has an entry for every layout of up to this many elements that forms compounds
+    uint8 maxElementCount;
+    uint16 entriesOffset;
+    //! The hash of the compound database image the table was generated from (see CompoundDatabase::GetImageHash)
+    uint32 databaseHash;
+    uint32 entryCount;
+};
+CompilerAssert(sizeof(OutcomeTableHeader) == 16);
+
+//! The outcome of a single layout, see ReactionOutcome.
+struct OutcomeTableEntry
+{
+    //! The data of the layout's ReactionKey, padded with REACTION_KEY_NO_NEIGHBOR when it has fewer than MAX_OUTCOME_TABLE_ELEMENTS elements
+    uint8 key[OUTCOME_TABLE_KEY_SIZE];
+    uint8 compoundCount;
+    uint8 compoundOf[MAX_OUTCOME_TABLE_ELEMENTS];
+    uint8 bondTypes[MAX_OUTCOME_TABLE_ELEMENTS][BondSide_Count];
+    uint8 bondData[MAX_OUTCOME_TABLE_ELEMENTS][BondSide_Count];
+    uint8 reserved;
+};
+CompilerAssert(sizeof(OutcomeTableEntry) == 44);
+
+//------------------------------------------------------------------------------
+// Outcome table
+//------------------------------------------------------------------------------
+//! Answers small reactions from a table of outcomes generated ahead of time instead of searching the compound database.
+//!
+//! The table only has entries for layouts that form compounds, any other layout with up to maxElementCount elements forms nothing.
+//! The table is only used while the compound database it was generated from is loaded.
+class OutcomeTable
+{
+public:
+    //! Loads the outcome table from an image. The image is used in place, so it must remain valid until another table is loaded or the table is
+    //! unloaded. Returns false and leaves the current table alone if the image is not a valid outcome table.
+    static bool Load(const void* image, uint32 size);
+    //! Stops using the current outcome table, if any.
+    static void Unload();
+#ifdef STANDALONE_APP
+    //! Memory-maps an outcome table image from the given file and loads it, returns false if the file could not be loaded.
+    static bool LoadFile(const char* path);
+#endif
+    static bool IsLoaded();
+
+    //! Looks up the outcome of a reaction with the given elements. Returns false if the table doesn't cover the reaction.
+    //! Otherwise the ideal compounds are rebuilt from the table and added to idealCompoundsOut with their bonds restored.
+    //! (None are added if the reaction doesn't form any compounds.)
+    static bool Lookup(ElementSet* elements, CompoundSet* idealCompoundsOut);
+
+    //! Builds the table entry for the layout with the given key by processing it with the current compound database, used to generate tables.
+    //! The key must be OUTCOME_TABLE_KEY_SIZE bytes. Returns false if it doesn't describe a valid layout of at least two elements in reaction order.
+    //! The entry's compoundCount is 0 if the layout doesn't form any compounds. No table may be loaded while entries are built.
+    static bool BuildEntry(const uint8* key, OutcomeTableEntry* entryOut);
+};
+
+#endif
@@ -65,6 +65,107 @@ namespace Sifteo
         va_end(args);
     }
 
+    const void* __map_file(const char* path, unsigned int* size_out)
+    {
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+        { return NULL; }
+
+        DWORD size = GetFileSize(file, NULL);
+        HANDLE mapping = size == INVALID_FILE_SIZE || size == 0 ? NULL : CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        // The view keeps the mapping (and the file) alive, so we don't need these handles anymore.
+        CloseHandle(file);
+        if (mapping == NULL)
+        { return NULL; }
+
+        const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+
+        if (data != NULL)
+        { *size_out = size; }
+        return data;
+    }
+
+    void __unmap_file(const void* data)
+    {
+        UnmapViewOfFile(data);
+    }
+
+    static_assert(sizeof(__lock) == sizeof(SRWLOCK), "__lock must be able to hold an SRWLOCK.");
+
+    void __lock::acquire()
+    {
+        AcquireSRWLockExclusive((PSRWLOCK)&state);
+    }
+
+    void __lock::release()
+    {
+        ReleaseSRWLockExclusive((PSRWLOCK)&state);
+    }
+
+    struct ParallelForWork
+    {
+        void(*callback)(int index, void* context);
+        void* context;
+        int count;
+        volatile LONG next;
+    };
+
+    //! Runs the remaining iterations of a __parallel_for until there are none left, every worker (and the calling thread) runs this.
+    static void CALLBACK ParallelForWorker(PTP_CALLBACK_INSTANCE instance, PVOID parameter, PTP_WORK threadPoolWork)
+    {
+        ParallelForWork* work = (ParallelForWork*)parameter;
+
+        for (int i = InterlockedIncrement(&work->next) - 1; i < work->count; i = InterlockedIncrement(&work->next) - 1)
+        { work->callback(i, work->context); }
+    }
+
+    void __parallel_for(int count, void(*callback)(int index, void* context), void* context)
+    {
+        ParallelForWork work;
+        work.callback = callback;
+        work.context = context;
+        work.count = count;
+        work.next = 0;
+
+        // There's no point in involving the thread pool for a single iteration:
+        PTP_WORK threadPoolWork = count > 1 ? CreateThreadpoolWork(ParallelForWorker, &work, NULL) : NULL;
+
+        if (threadPoolWork != NULL)
+        {
+            for (int i = 1; i < count; i++)
+            { SubmitThreadpoolWork(threadPoolWork); }
+        }
+
+        // The calling thread helps out rather than sitting idle:
+        ParallelForWorker(NULL, &work, NULL);
+
+        if (threadPoolWork != NULL)
+        {
+            WaitForThreadpoolWorkCallbacks(threadPoolWork, FALSE);
+            CloseThreadpoolWork(threadPoolWork);
+        }
+    }
+
+    SystemTime SystemTime::now()
+    {
+        static LARGE_INTEGER frequency;
+        if (frequency.QuadPart == 0)
+        { QueryPerformanceFrequency(&frequency); }
+
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+
+        SystemTime ret;
+        ret.microseconds = counter.QuadPart / frequency.QuadPart * 1000000 + counter.QuadPart % frequency.QuadPart * 1000000 / frequency.QuadPart;
+        return ret;
+    }
+
+    int64_t SystemTime::uptimeUS() const
+    {
+        return microseconds;
+    }
+
     void System::paint()
     {
         ASSERT(PaintCallback != NULL);
@@ -19,7 +19,27 @@ namespace Sifteo
 {
     void __do_log(const char* format, ...);
 
+    //! Maps the given file into memory as read-only, returns NULL on failure. (Standalone only, the Sifteo equivalent is embedding the data.)
+    const void* __map_file(const char* path, unsigned int* size_out);
+    //! Unmaps a file mapped by __map_file.
+    void __unmap_file(const void* data);
+
+    //! A lock for engine state shared by reactions that are evaluated on worker threads. A zero-initialized lock is unlocked.
+    //! (Standalone only, Sifteo games are single-threaded.)
+    struct __lock
+    {
+        void* state;
+
+        void acquire();
+        void release();
+    };
+
+    //! Calls callback(index, context) for each index from 0 to count - 1 on a pool of worker threads, and returns once all of them have finished.
+    //! (Standalone only, used to evaluate independent reactions in parallel.)
+    void __parallel_for(int count, void(*callback)(int index, void* context), void* context);
+
     typedef unsigned char uint8_t;
+    typedef long long int64_t;
 
     typedef uint8_t CubeID;
     #define INVALID_CUBE_ID ((CubeID)-1)
@@ -39,6 +59,15 @@ namespace Sifteo
         FB32
     };
 
+    class SystemTime
+    {
+    private:
+        int64_t microseconds;
+    public:
+        static SystemTime now();
+        int64_t uptimeUS() const;
+    };
+
     class System
     {
     public:
@@ -1,339 +1,201 @@
 #include "Reaction.h"
 #include "Element.h"
-
-//TODO: All of the ReactionNode stuff needs to be moved to separate files.
-
-#define MAX_REACTION_DEPTH (sizeof(uint32) * 8 - 2)
-#define ELEMENT_IN_USE_BIT (MAX_REACTION_DEPTH + 1)
-
-//HACK: This is to get around ReactionNode not having a reference to the current reaction, make this not awful later.
-Reaction* currentReaction;
-
-class ReactionNode
+#include "CompoundDatabase.h"
+#include "ReactionCache.h"
+#include "ReactionSnapshot.h"
+#include "OutcomeTable.h"
+#include "ReactionStats.h"
+
+CompilerAssert(MAX_CANDIDATE_COMPOUNDS <= sizeof(uint32) * 8);
+CompilerAssert(NUM_CUBES * MAX_DATABASE_PATTERNS <= 0x10000); // Candidate keys must fit in a uint16
+
+//! The state of the search for the best combination of non-overlapping compounds.
+//! Each candidate compound is represented by a mask of the elements it contains (bit N is element N of the reaction.)
+//!
+//! A combination is better than another if it covers more elements with compounds that don't contain potential bonds, then if it covers more
+//! elements in total, then if it uses fewer compounds. (So a single large compound is preferred over smaller compounds covering the same elements.)
+//! Ties go to the combination found first. Candidates are ordered by their root element and then by their pattern's position in the database,
+//! regardless of the order the patterns were tried in.
+struct CompoundSelection
 {
-protected:
-    ReactionNode* firstChild = NULL;
-    ReactionNode* sibling = NULL;
-    BondType type = BondType_None;
-    int leftData = 0;
-    int rightData = 0;
-public:
-    class Iterator
-    {
-    private:
-        ReactionNode** marker;
-    public:
-        Iterator(ReactionNode** start)
-        {
-            this->marker = start;
-        }
-
-        void Next()
-        {
-            if (*marker != NULL)
-            { marker = &(*marker)->sibling; }
-        }
-
-        ReactionNode* Get() const
-        {
-            return *marker;
-        }
-
-        Iterator& operator++()
-        {
-            Next();
-            return *this;
-        }
-
-        Iterator& operator++(int)
-        {
-            return ++(*this);
-        }
-
-        ReactionNode* operator*() const
-        {
-            return Get();
-        }
-
-        bool HasNext()
-        {
-            return *marker != NULL && (*marker)->sibling != NULL;
-        }
-
-        ReactionNode** GetMarker()
-        {
-            return marker;
-        }
-
-        void GoToEnd()
-        {
-            while (HasNext())
-            { Next(); }
-        }
-
-        uint32 Count()
-        {
-            uint32 ret = 0;
-            while (HasNext())
-            {
-                Next();
-                ret++;
-            }
-            return ret;
-        }
-    };
-
-    void AddSibling(ReactionNode* node)
-    {
-        Iterator it(&sibling);
-        it.GoToEnd();
-        it.Next(); // Get marker on location to place node.
-        *(it.GetMarker()) = node;
-    }
+    int candidateCount;
+    ElementMask masks[MAX_CANDIDATE_COMPOUNDS];
+    bool isStable[MAX_CANDIDATE_COMPOUNDS];
+    //! The elements that could still be covered by the (stable) candidates at or after each index, used to bound the search.
+    ElementMask remainingMasks[MAX_CANDIDATE_COMPOUNDS + 1];
+    ElementMask remainingStableMasks[MAX_CANDIDATE_COMPOUNDS + 1];
+
+    //! Bit N is set if candidate N is part of the best combination
+    uint32 best;
+    int bestStableCount;
+    int bestElementCount;
+    int bestCompoundCount;
+};
 
-    void AddChild(ReactionNode* node)
-    {
-        Iterator it(&firstChild);
-        it.GoToEnd();
-        it.Next(); // Get marker on location to place node.
-        *(it.GetMarker()) = node;
-    }
+static int CountBits(ElementMask value)
+{
+    int ret = 0;
+    for (; value != 0; value &= value - 1)
+    { ret++; }
+    return ret;
+}
 
-    void SetBondInfo(BondType type, int leftData, int rightData)
+//! Searches the combinations of the candidates at or after the given index, with the given candidates already chosen.
+//! Each candidate is first tried as part of the combination, then without it.
+static void SelectCompounds(CompoundSelection* s, int index, uint32 chosen, ElementMask used, int stableCount, int elementCount, int compoundCount)
+{
+    // Remember this combination if it is better than the best one so far:
+    if (stableCount > s->bestStableCount ||
+        (stableCount == s->bestStableCount && elementCount > s->bestElementCount) ||
+        (stableCount == s->bestStableCount && elementCount == s->bestElementCount && compoundCount < s->bestCompoundCount))
     {
-        this->type = type;
-        this->leftData = leftData;
-        this->rightData = rightData;
+        s->best = chosen;
+        s->bestStableCount = stableCount;
+        s->bestElementCount = elementCount;
+        s->bestCompoundCount = compoundCount;
     }
 
-    void SetBondInfo(BondType type, int data)
-    { SetBondInfo(type, data, data); }
+    if (index >= s->candidateCount)
+    { return; }
 
-    void SetBondInfo(BondType type)
-    { SetBondInfo(type, 0, 0); }
+    // Stop if even covering every remaining element can't beat the best combination.
+    // (When it could only tie the best coverage, it can still win by using fewer compounds, but only if we haven't already used as many.)
+    int maxStableCount = stableCount + CountBits(s->remainingStableMasks[index] & ~used);
+    int maxElementCount = elementCount + CountBits(s->remainingMasks[index] & ~used);
+    if (maxStableCount < s->bestStableCount)
+    { return; }
+    if (maxStableCount == s->bestStableCount && maxElementCount < s->bestElementCount)
+    { return; }
+    if (maxStableCount == s->bestStableCount && maxElementCount == s->bestElementCount && compoundCount + 1 >= s->bestCompoundCount)
+    { return; }
 
-    void ApplyBond(Compound* compound, Element* left, Element* right)
+    ElementMask mask = s->masks[index];
+    if ((mask & used) == 0)
     {
-        // We need to set the IN_USE bit even if no bond needs to be added.
-        left->SetMaskBit(ELEMENT_IN_USE_BIT);
-        right->SetMaskBit(ELEMENT_IN_USE_BIT);
-
-        if (this->type == BondType_None)
-        { return; }
-
-        //LOG("ApplyBond(Compound:0x%X, Element:0x%X, Element:0x%X)\n", compound, left, right);
-        Assert(left != right); // This means a bond was applied to a passthrough node.
-
-        left->SetBondTypeFor(compound, right, type, leftData, rightData);
+        int count = CountBits(mask);
+        SelectCompounds(s, index + 1, chosen | (1 << index), used | mask, stableCount + (s->isStable[index] ? count : 0), elementCount + count, compoundCount + 1);
     }
 
-    virtual bool ProcessChildren(Compound* compound, Element* inputForChildren, int depth)
-    {
-        for (Iterator it(&firstChild); *it; it++)
-        {
-            if (!(*it)->Process(compound, inputForChildren, depth))
-            {
-                return false; // All children must return true to succeed.
-            }
-        }
-
-        return true; // If we got this far, all children met their criteria.
-    }
-
-    // Don't override this for most implementations of this class
-    virtual bool Process(Compound* compound, Element* input, int depth)
-    {
-        //LOG("%s:0x%X.Process(Compound:0x%X, Element:0x%X[%s], %d)\n", GetDescription(), this, compound, input, input->GetSymbol(), depth);
-        Assert(depth >= 0 && depth < MAX_REACTION_DEPTH);
-        bool success = false;
-        Element* output = NULL;
-        Element* lastOutput = NULL;
-
-        while (true)
-        {
-            // This will return a different element each time it is called, and NULL when no element is available
-            // Therefore, we can loop until we find an element with child elements that satisfy this branch of the reaction.
-            lastOutput = output;
-            output = GetOutput(compound, input, depth);
-
-            // If output == NULL, we ran out of possibilities and failed.
-            // If output == lastOutput, then either the node has a flawed implementation, or (more likely) it is a dummy pass-through node. Either way we want to not loop forever.
-            if (output == NULL || output == lastOutput)
-            { break; }
-
-            // Mark this element as being used for this depth of the compound processing
-            output->SetMaskBit(depth);
-
-            // Process children (on the next depth)
-            if (ProcessChildren(compound, output, depth + 1))
-            {
-                // All children succeeded, so we succeed!
-                success = true;
-                break;
-            }
-        }
+    SelectCompounds(s, index + 1, chosen, used, stableCount, elementCount, compoundCount);
+}
 
-        currentReaction->ClearElementMasks(depth); // Clear all of the elements we considered for this branch
-        if (success)
-        { ApplyBond(compound, input, output); }
-        return success;
-    }
+//! Returns true if the first candidate is less useful than the second, which is used to decide which candidate to drop when there are too many.
+//! This ranks single candidates the same way combinations are ranked, see CompoundSelection.
+static bool IsWorseCandidate(const CompoundCandidate* a, const CompoundCandidate* b)
+{
+    if (a->isStable != b->isStable)
+    { return b->isStable; }
 
-    // Override this for most implementations of this class
-    virtual Element* GetOutput(Compound* compound, Element* input, int depth)
-    {
-        LOG("WARN: Called unimplemented ReactionNode:GetOutput with Element:0x%X[%s] as input @ depth %d!\n", input, input->GetSymbol(), depth);
-        return NULL;
-    }
+    int aCount = CountBits(a->elementMask);
+    int bCount = CountBits(b->elementMask);
+    if (aCount != bCount)
+    { return aCount < bCount; }
 
-    Iterator GetChildIterator()
-    {
-        return Iterator(&firstChild);
-    }
-
-    virtual const char* GetDescription() { return "ReactionNode"; }
-};
+    return a->key > b->key;
+}
 
-class ElementSymbolFilterNode : public ReactionNode
+void Reaction::AddCandidate(CompoundCandidate* candidates, int* candidateCount, const CompoundCandidate* candidate)
 {
-private:
-    const char* symbol;
-public:
-    ElementSymbolFilterNode(const char* symbol)
+    // Candidates with the same elements are interchangeable in every combination, so only the better one can ever be chosen:
+    // (A stable compound always beats an unstable one, otherwise the one that comes first wins ties.)
+    for (int i = 0; i < *candidateCount; i++)
     {
-        this->symbol = symbol;
-        LOG("ElementSymbolFilterNode:0x%X %s\n", this, symbol);
-    }
+        if (candidates[i].elementMask != candidate->elementMask)
+        { continue; }
 
-    virtual Element* GetOutput(Compound* compound, Element* input, int depth)
-    {
-        return strcmp(input->GetSymbol(), symbol) == 0 ? input : NULL;
+        if (IsWorseCandidate(&candidates[i], candidate))
+        { candidates[i] = *candidate; }
+        return;
     }
 
-    virtual const char* GetDescription() { return "ElementSymbolFilterNode"; }
-};
-
-class ElementSymbolNode : public ReactionNode
-{
-private:
-    const char* symbol;
-public:
-    ElementSymbolNode(const char* symbol)
+    if (*candidateCount < MAX_CANDIDATE_COMPOUNDS)
     {
-        this->symbol = symbol;
-        LOG("ElementSymbolNode:0x%X %s\n", this, symbol);
+        candidates[(*candidateCount)++] = *candidate;
+        return;
     }
 
-    virtual Element* GetOutput(Compound* compound, Element* input, int depth)
+    // Out of room, replace the least useful candidate if the new one is better:
+    LOG("WARNING: Reaction:0x%X found more than %d candidate compounds, dropping the least useful one.\n", this, MAX_CANDIDATE_COMPOUNDS);
+    int worst = 0;
+    for (int i = 1; i < *candidateCount; i++)
     {
-        return input->GetBondWith(symbol);
+        if (IsWorseCandidate(&candidates[i], &candidates[worst]))
+        { worst = i; }
     }
 
-    virtual const char* GetDescription() { return "ElementSymbolNode"; }
-};
+    if (IsWorseCandidate(&candidates[worst], candidate))
+    { candidates[worst] = *candidate; }
+}
 
-class ElementGroupFilterNode : public ReactionNode
+void Reaction::ChooseIdealCompounds(CompoundCandidate* candidates, int candidateCount, ReactionSnapshot* snapshot)
 {
-private:
-    groupState group;
-public:
-    ElementGroupFilterNode(groupState group)
-    {
-        this->group = group;
-        LOG("ElementGroupFilterNode:0x%X %d\n", this, group);
-    }
+    CompoundSelection s;
+    s.candidateCount = candidateCount;
 
-    virtual Element* GetOutput(Compound* compound, Element* input, int depth)
+    // Sort the candidates by their keys: (The patterns are tried largest first, so the candidates aren't found in this order.)
+    for (int i = 1; i < candidateCount; i++)
     {
-        return input->GetGroup() == group ? input : NULL;
+        CompoundCandidate candidate = candidates[i];
+        int position = i;
+        for (; position > 0 && candidates[position - 1].key > candidate.key; position--)
+        { candidates[position] = candidates[position - 1]; }
+        candidates[position] = candidate;
     }
 
-    virtual const char* GetDescription() { return "ElementGroupFilterNode"; }
-};
-
-class ElementGroupNode : public ReactionNode
-{
-private:
-    groupState group;
-public:
-    ElementGroupNode(groupState group)
+    for (int i = 0; i < s.candidateCount; i++)
     {
-        this->group = group;
-        LOG("ElementGroupNode:0x%X %d\n", this, group);
+        s.masks[i] = candidates[i].elementMask;
+        s.isStable[i] = candidates[i].isStable;
     }
 
-    virtual Element* GetOutput(Compound* compound, Element* input, int depth)
+    s.remainingMasks[s.candidateCount] = 0;
+    s.remainingStableMasks[s.candidateCount] = 0;
+    for (int i = s.candidateCount - 1; i >= 0; i--)
     {
-        return input->GetBondWith(group);
+        s.remainingMasks[i] = s.remainingMasks[i + 1] | s.masks[i];
+        s.remainingStableMasks[i] = s.remainingStableMasks[i + 1] | (s.isStable[i] ? s.masks[i] : 0);
     }
 
-    virtual const char* GetDescription() { return "ElementGroupNode"; }
-};
+    s.best = 0;
+    s.bestStableCount = 0;
+    s.bestElementCount = 0;
+    s.bestCompoundCount = 0;
+    SelectCompounds(&s, 0, 0, 0, 0, 0, 0);
 
-// A logical node that only needs one branch of children to succeed
-//NOTE: This should not be used to implement alternative, inclusive reactions as it will not even try the other children once one succeeds.
-class EitherOrNode : public ReactionNode
-{
-public:
-    virtual bool ProcessChildren(Compound* compound, Element* inputForChildren, int depth)
+    // Find the chosen compounds again: (The search is deterministic, so this always builds the same compound as the first time.)
+    for (int i = 0; i < s.candidateCount; i++)
     {
-        for (Iterator it(&firstChild); *it; it++)
-        {
-            if ((*it)->Process(compound, inputForChildren, depth))
-            {
-                return true; // Return true when the first child succeeds.
-            }
-        }
-
-        return false; // If we got this far, then no children succeedeed.
-    }
+        if (!(s.best & (1 << i)))
+        { continue; }
 
-    virtual Element* GetOutput(Compound* compound, Element* input, int depth)
-    {
-        // This node is a pure pass-through node
-        return input;
+        Compound* compound = new Compound(idealCompounds.Count());
+        snapshot->StartCompound();
+        if (!CompoundDatabase::ProcessPattern(candidates[i].key % MAX_DATABASE_PATTERNS, this, snapshot, compound, candidates[i].key / MAX_DATABASE_PATTERNS, NULL))
+        { AssertAlways(); }
+        idealCompounds.Add(compound);
     }
+}
 
-    virtual const char* GetDescription() { return "EitherOrNode"; }
-};
-
-//! This node doesn't do anything other than pass the element through, used for coalescing common elements after an EitherOrNode.
-class NoOpNode : public ReactionNode
+bool Reaction::Process()
 {
-public:
-    virtual Element* GetOutput(Compound* compound, Element* input, int depth)
-    {
-        // This node is a pure pass-through node
-        return input;
-    }
-
-    virtual const char* GetDescription() { return "NoOpNode"; }
-};
-
-void InitializeCompoundDatabase();
-
-ReactionNode CompoundDatabaseRoot;
+    Evaluate();
+    return Apply();
+}
 
 /*
-Processes a reaction and determines the outcome, if any.
+Determines the outcome of a reaction, if any.
 
 This algorithm was written with help by:
 Christopher Culbertson, Associate Professor at Kansas State University
 Michael Ayala, Chemistry Major at UC Davis
 */
-bool Reaction::Process()
+void Reaction::Evaluate()
 {
-    // Initialize the compound database
-    static bool compoundDatabaseIsInitialized = false;
-    if (!compoundDatabaseIsInitialized)
-    {
-        InitializeCompoundDatabase();
-        compoundDatabaseIsInitialized = true;
-    }
+    Assert(idealCompounds.Count() == 0); // Reactions are only evaluated once.
 
     // Fail immediately if there's only one element in this reaction
     if (elements.Count() == 1)
-    { return false; }
+    { return; }
 
     // Debug printing
     LOG("Reaction:0x%X processing %d elements...\n", this, elements.Count());
@@ -346,373 +208,102 @@ bool Reaction::Process()
     }
     LOG(" ]\n");
 
-    currentReaction = this;
+    // Rule out the patterns that need elements this reaction doesn't have, and give up right away if nothing could possibly form:
+    ReactionSignature signature;
+    signature.Build(&elements);
+    uint32 possiblePatterns = CompoundDatabase::GetPossiblePatterns(&signature);
+    uint32 anyPatterns = 0;
     for (int i = 0; i < elements.Count(); i++)
-    {
-        LOG("Processing element %d:%s as root to compound...\n", i, elements[i]->GetSymbol());
-        
-        for (ReactionNode::Iterator it = CompoundDatabaseRoot.GetChildIterator(); *it; it++)
-        {
-            Compound* newCompound = StartNewCompound();
-            if (!(*it)->Process(newCompound, elements[i], 0))
-            { CancelCompound(newCompound); } // Cancel the compound if the process was not successful.
-        }
-    }
-
-    LOG("Reaction processing completed with %d candidate compounds.\n", possibleCompounds.Count());
-
-    //--------------------------------------------------------------------------
-    // Choose the ideal compound and apply it:
-    //--------------------------------------------------------------------------
-    //TODO: Allow multiple compounds to form in one reaction when they don't overlap.
-    idealCompound = NULL;
-    for (int i = 0; i < possibleCompounds.Count(); i++)
-    {
-        Compound* compound = possibleCompounds[i];
-
-        if (idealCompound == NULL)
-        {
-            idealCompound = compound;
-            continue;
-        }
-
-        if (idealCompound->ContainsPotentialBonds() && !compound->ContainsPotentialBonds())
-        {
-            idealCompound = compound;
-            continue;
-        }
-
-        if (idealCompound->GetElementCount() < compound->GetElementCount())
-        {
-            idealCompound = compound;
-            continue;
-        }
-    }
-
-    // Dispose of all compounds other than the ideal one to save memory
-    for (int i = 0; i < possibleCompounds.Count(); i++)
-    {
-        if (possibleCompounds[i] != idealCompound)
-        {
-            delete possibleCompounds[i];
-        }
-    }
-    // Clear the possible compounds list to release the linked list memory (The ideal compound will survive.)
-    possibleCompounds.Clear();
-
-    // Apply the ideal compound and return
-    if (idealCompound != NULL)
-    {
-        idealCompound->Apply();
-        return true;
-    }
-    return false;
-}
-
-//------------------------------------------------------------------------------
-// Nodes for potential compounds
-//------------------------------------------------------------------------------
-//TOOD: Either make this nicer or generate it with a tool. (I'm leaning towards the latter.)
-namespace PerchloricAcid
-{
-    ElementSymbolFilterNode root("Cl");
-    ElementSymbolNode node_1("O");
-    ElementSymbolNode node_1_1("H");
-    ElementSymbolNode node_2("O");
-    ElementSymbolNode node_3("O");
-    ElementSymbolNode node_4("O");
-
-    void Initialize()
-    {
-        root.AddChild(&node_1);
-        root.AddChild(&node_2);
-        root.AddChild(&node_3);
-        root.AddChild(&node_4);
-
-        node_1.AddChild(&node_1_1);
-
-        node_1.SetBondInfo(BondType_Covalent, 1);
-        node_2.SetBondInfo(BondType_Covalent, 2);
-        node_3.SetBondInfo(BondType_Covalent, 2);
-        node_4.SetBondInfo(BondType_Covalent, 2);
-
-        node_1_1.SetBondInfo(BondType_Covalent, 1);
-
-        CompoundDatabaseRoot.AddChild(&root);
-    }
-}
-
-namespace Acetylene
-{
-    ElementSymbolFilterNode h1("H");
-    ElementSymbolNode c1("C");
-    ElementSymbolNode c2("C");
-    ElementSymbolNode h2("H");
-
-    void Initialize()
-    {
-        h1.AddChild(&c1);
-        c1.AddChild(&c2);
-        c2.AddChild(&h2);
-
-        c1.SetBondInfo(BondType_Covalent, 1);
-        c2.SetBondInfo(BondType_Covalent, 3);
-        h2.SetBondInfo(BondType_Covalent, 1);
-
-        CompoundDatabaseRoot.AddChild(&h1);
-    }
-}
-
-namespace DisulfurDioxide
-{
-    ElementSymbolFilterNode o1("O");
-    ElementSymbolNode s1("S");
-    ElementSymbolNode s2("S");
-    ElementSymbolNode o2("O");
+    { anyPatterns |= CompoundDatabase::GetPatternsFor(elements[i]); }
 
-    void Initialize()
+    if ((anyPatterns & possiblePatterns) == 0)
     {
-        o1.AddChild(&s1);
-        s1.AddChild(&s2);
-        s2.AddChild(&o2);
-
-        s1.SetBondInfo(BondType_Covalent, 2);
-        s2.SetBondInfo(BondType_Covalent, 1);
-        o2.SetBondInfo(BondType_Covalent, 2);
-
-        CompoundDatabaseRoot.AddChild(&o1);
+        LOG("No compounds can form from these elements.\n");
+        return;
     }
-}
 
-namespace PhosphorousAcid1 /* H3PO3 Tautomer */
-{
-    ElementSymbolFilterNode p("P");
-    ElementSymbolNode o1("O");
-    ElementSymbolNode o2("O");
-    ElementSymbolNode o3("O");
-    ElementSymbolNode h1("H");
-    ElementSymbolNode h2("H");
-    ElementSymbolNode h3("H");
-
-    void Initialize()
+    // Small reactions can be answered by the outcome table, if one is loaded:
+    if (OutcomeTable::Lookup(&elements, &idealCompounds))
     {
-        p.AddChild(&o1);
-        p.AddChild(&o2);
-        p.AddChild(&o3);
-
-        o1.AddChild(&h1);
-        o2.AddChild(&h2);
-        o3.AddChild(&h3);
-
-        o1.SetBondInfo(BondType_Covalent, 1);
-        o2.SetBondInfo(BondType_Covalent, 1);
-        o3.SetBondInfo(BondType_Covalent, 1);
-        h1.SetBondInfo(BondType_Ionic);
-        h2.SetBondInfo(BondType_Ionic);
-        h3.SetBondInfo(BondType_Ionic);
-
-        CompoundDatabaseRoot.AddChild(&p);
+        LOG("Reaction outcome came from the outcome table.\n");
+        return;
     }
-}
 
-namespace PhosphorousAcid2 /* H2PHO3 Tautomer */
-{
-    ElementSymbolFilterNode p("P");
-    ElementSymbolNode o1("O");
-    ElementSymbolNode o2("O");
-    ElementSymbolNode o3("O");
-    ElementSymbolNode h1("H");
-    ElementSymbolNode h2("H");
-    ElementSymbolNode h3("H");
-
-    void Initialize()
+    // Reuse the outcome of an identical reaction if we've processed one recently:
+    if (ReactionCache::Lookup(&elements, &idealCompounds))
     {
-        p.AddChild(&o1);
-        p.AddChild(&o2);
-        p.AddChild(&o3);
-        p.AddChild(&h1);
-
-        o1.AddChild(&h2);
-        o2.AddChild(&h3);
-
-        o1.SetBondInfo(BondType_Covalent, 2);
-        o2.SetBondInfo(BondType_Covalent, 1);
-        o3.SetBondInfo(BondType_Covalent, 1);
-        h1.SetBondInfo(BondType_Covalent, 1);
-        h2.SetBondInfo(BondType_Ionic);
-        h3.SetBondInfo(BondType_Ionic);
-
-        CompoundDatabaseRoot.AddChild(&p);
+        LOG("Reaction outcome was cached. (%d hits, %d misses)\n", ReactionCache::GetHitCount(), ReactionCache::GetMissCount());
+        return;
     }
-}
-
-//------------------------------------------------------------------------------
-// Two Element Reactions
-//------------------------------------------------------------------------------
-namespace Hydrogen_HydrogenOrHalogenOrAlkali
-{
-    //Hydrogen - Hydrogen
-    ElementGroupFilterNode h_h1(HYDROGEN);
-    ElementGroupNode h_h2(HYDROGEN);
-
-    // Hydrogen - Halogen
-    ElementGroupFilterNode h_hal1(HYDROGEN);
-    ElementGroupNode h_hal2(HALOGEN);
 
-    // Hydrogen - Alkali
-    ElementGroupFilterNode h_a1(HYDROGEN);
-    ElementGroupNode h_a2(ALKALI);
+    // The search works on a dense copy of the elements rather than the elements themselves:
+    ReactionSnapshot snapshot;
+    snapshot.Build(&elements);
 
-    void Initialize()
-    {
-        h_h1.AddChild(&h_h2);
-        h_h2.SetBondInfo(BondType_Covalent, 1);
-        CompoundDatabaseRoot.AddChild(&h_h1);
-
-        h_hal1.AddChild(&h_hal2);
-        h_hal2.SetBondInfo(BondType_Covalent, 1);
-        CompoundDatabaseRoot.AddChild(&h_hal1);
-
-        h_a1.AddChild(&h_a2);
-        h_a2.SetBondInfo(BondType_Ionic);
-        CompoundDatabaseRoot.AddChild(&h_a1);
-    }
-}
-
-namespace Halogen_HalogenOrAlkali
-{
-    // Halogen - Halogen
-    ElementGroupFilterNode ha_ha1(HALOGEN);
-    ElementGroupNode ha_ha2(HALOGEN);
+    // Every compound found is scored as a candidate right away, so that only a fixed number of them needs to be kept:
+    CompoundCandidate candidates[MAX_CANDIDATE_COMPOUNDS];
+    int candidateCount = 0;
 
-    // Halogen - Alkali
-    ElementGroupFilterNode ha_a1(HALOGEN);
-    ElementGroupNode ha_a2(ALKALI);
+    // Bit N of entry I is set once pattern N is known to fail with element I as its root, because a prefix it shares with another pattern failed:
+    uint32 failedPatterns[NUM_CUBES];
+    PeriodicMemset(failedPatterns, 0, sizeof(failedPatterns));
 
-    void Initialize()
+    // Patterns are tried largest first so that a compound covering the entire reaction is likely to be found early.
+    // Nothing can beat a compound like that (without potential bonds), so the remaining patterns are skipped as soon as we find one.
+    bool foundCompleteCompound = false;
+    for (int n = 0; n < CompoundDatabase::GetPatternCount() && !foundCompleteCompound; n++)
     {
-        ha_ha1.AddChild(&ha_ha2);
-        ha_ha2.SetBondInfo(BondType_Covalent, 1);
-        CompoundDatabaseRoot.AddChild(&ha_ha1);
+        int p = CompoundDatabase::GetPatternLargestFirst(n);
+        if (!(possiblePatterns & (1 << p)))
+        { continue; }
 
-        ha_a1.AddChild(&ha_a2);
-        ha_a2.SetBondInfo(BondType_Ionic);
-        CompoundDatabaseRoot.AddChild(&ha_a1);
-    }
-}
+        LOG("Processing pattern %s...\n", CompoundDatabase::GetPatternName(p));
 
-namespace LithiumIodine
-{
-    ElementSymbolFilterNode root("Li");
-    ElementSymbolNode node_1("I");
+        // Only use the elements whose root filter could accept this pattern as its root:
+        for (int i = 0; i < elements.Count() && !foundCompleteCompound; i++)
+        {
+            if (!(CompoundDatabase::GetPatternsFor(elements[i]) & (1 << p)) || (failedPatterns[i] & (1 << p)))
+            { continue; }
+
+            // Don't bother searching from elements that don't have the neighbors the pattern's root bonds to:
+            if (!CompoundDatabase::HasRootNeighbors(p, &snapshot, i))
+            { continue; }
+
+            // Candidates are found without a Compound, the snapshot records everything about their bonds that's needed to choose between them.
+            // (The chosen ones are found again by ChooseIdealCompounds.) So trying a pattern doesn't touch the compound pool or the elements at all.
+            ReactionStats::BeginPattern(this);
+            ReactionStatsCount(this, patternsTried);
+            snapshot.StartCompound(); // None of the elements are in use for the new compound yet
+            int nodesReached;
+            if (CompoundDatabase::ProcessPattern(p, this, &snapshot, NULL, i, &nodesReached))
+            {
+                CompoundCandidate candidate;
+                candidate.key = (uint16)(i * MAX_DATABASE_PATTERNS + p);
+                candidate.elementMask = snapshot.bondedElements;
+                candidate.isStable = !snapshot.hasPotentialBonds;
 
-    void Initialize()
-    {
-        root.AddChild(&node_1);
-        node_1.SetBondInfo(BondType_Ionic);
-        CompoundDatabaseRoot.AddChild(&root);
-    }
-}
+                foundCompleteCompound = CountBits(candidate.elementMask) == elements.Count() && candidate.isStable;
+                AddCandidate(candidates, &candidateCount, &candidate);
+            }
+            else
+            {
+                ReactionStatsCount(this, patternsFailed);
 
-//------------------------------------------------------------------------------
-// Three Element Reactions
-//------------------------------------------------------------------------------
-namespace AlkaliEarth_2Halogen
-{
-    ElementGroupFilterNode halogenRoot(ALKALIEARTH);
-    EitherOrNode or1; // Used as if-else for Be
-        ElementSymbolFilterNode beFilter("Be");
-            ElementGroupNode be_1(HALOGEN);
-            ElementGroupNode be_2(HALOGEN);
-        /* else */
-        NoOpNode elseNode;
-            ElementGroupNode else_1(HALOGEN);
-            ElementGroupNode else_2(HALOGEN);
-
-    void Initialize()
-    {
-        halogenRoot.AddChild(&or1);
-        or1.AddChild(&beFilter);
-        {
-            //If the alkali earth metal is Beryllium, the bond will be covalent
-            beFilter.AddChild(&be_1);
-            beFilter.AddChild(&be_2);
-            be_1.SetBondInfo(BondType_Covalent, 1);
-            be_2.SetBondInfo(BondType_Covalent, 1);
-        }
-        or1.AddChild(&elseNode);
-        {
-            //If they are the other alkali earth metals, they will make an ionic bond
-            elseNode.AddChild(&else_1);
-            elseNode.AddChild(&else_2);
-            else_1.SetBondInfo(BondType_Ionic);
-            else_2.SetBondInfo(BondType_Ionic);
+                // The part of the pattern the search got to failed by itself, so every pattern that starts the same way fails from this root too:
+                failedPatterns[i] |= CompoundDatabase::GetPatternsSharingPrefix(p, nodesReached);
+            }
+            ReactionStats::EndPattern(this, p);
         }
-
-        CompoundDatabaseRoot.AddChild(&halogenRoot);
     }
-}
+    ReactionStats::EndSearch();
 
-namespace AlkaliEarth_2Hydrogen
-{
-    ElementGroupFilterNode halogenRoot(ALKALIEARTH);
-    EitherOrNode or1; // Used as if-else for Be
-        ElementSymbolFilterNode beFilter("Be");
-            ElementGroupNode be_1(HYDROGEN);
-            ElementGroupNode be_2(HYDROGEN);
-        /* else if */
-        ElementSymbolFilterNode mgFilter("Mg");
-            ElementGroupNode mg_1(HYDROGEN);
-            ElementGroupNode mg_2(HYDROGEN);
-        /* else */
-        NoOpNode elseNode;
-            ElementGroupNode else_1(HYDROGEN);
-            ElementGroupNode else_2(HYDROGEN);
-
-    void Initialize()
-    {
-        halogenRoot.AddChild(&or1);
-        or1.AddChild(&beFilter);
-        {
-            //If the alkali earth metal is Beryllium, the bond will be covalent
-            beFilter.AddChild(&be_1);
-            beFilter.AddChild(&be_2);
-            be_1.SetBondInfo(BondType_Covalent, 1);
-            be_2.SetBondInfo(BondType_Covalent, 1);
-        }
-        or1.AddChild(&mgFilter);
-        {
-            //If the alkali earth metal is Magnesium, the bond will be covalent
-            mgFilter.AddChild(&mg_1);
-            mgFilter.AddChild(&mg_2);
-            mg_1.SetBondInfo(BondType_Covalent, 1);
-            mg_2.SetBondInfo(BondType_Covalent, 1);
-        }
-        or1.AddChild(&elseNode);
-        {
-            //If they are the other alkali earth metals, they will make an ionic bond
-            elseNode.AddChild(&else_1);
-            elseNode.AddChild(&else_2);
-            else_1.SetBondInfo(BondType_Ionic);
-            else_2.SetBondInfo(BondType_Ionic);
-        }
+    LOG("Reaction processing completed with %d candidate compounds.\n", candidateCount);
 
-        CompoundDatabaseRoot.AddChild(&halogenRoot);
-    }
-}
+    //--------------------------------------------------------------------------
+    // Choose the ideal compounds:
+    //--------------------------------------------------------------------------
+    ChooseIdealCompounds(candidates, candidateCount, &snapshot);
+    LOG("Chose %d non-overlapping compounds.\n", idealCompounds.Count());
 
-void InitializeCompoundDatabase()
-{
-    LOG("Initializing compound database...\n");
-    PerchloricAcid::Initialize();
-    Hydrogen_HydrogenOrHalogenOrAlkali::Initialize();
-    Halogen_HalogenOrAlkali::Initialize();
-    LithiumIodine::Initialize();
-    AlkaliEarth_2Halogen::Initialize();
-    AlkaliEarth_2Hydrogen::Initialize();
-    Acetylene::Initialize();
-    DisulfurDioxide::Initialize();
-    PhosphorousAcid1::Initialize();
-    PhosphorousAcid2::Initialize();
-    LOG("Done initializing compound database with %d compounds.\n", CompoundDatabaseRoot.GetChildIterator().Count());
+    ReactionCache::Store(&elements, &idealCompounds);
 }
@@ -2,17 +2,37 @@
 #include "Element.h"
 #include "Set.h"
 #include "Compound.h"
+#include "CompoundSet.h"
 #include "ObjectPool.h"
-#include "LinkedList.h"
+#include "ReactionStats.h"
 
 #include <sifteo.h>
 
+struct ReactionSnapshot;
+
+//! The most candidate compounds Reaction::Evaluate keeps track of, limited by the combinations ChooseIdealCompounds can represent.
+#define MAX_CANDIDATE_COMPOUNDS ((int)(sizeof(uint32) * 8))
+
+//! A compound found by the reaction search.
+//! Candidates only keep what's needed to choose between them and to find the compound again, so the search doesn't need a Compound at all.
+//! The element mask and stability are the compound's signature: Choosing compounds never looks at anything else, so candidates with the same
+//! signature are duplicates even if they were found from different roots or by different patterns. (Like H-H, which matches from either end.)
+struct CompoundCandidate
+{
+    //! The index of the root element times MAX_DATABASE_PATTERNS plus the pattern, which orders them by root element and then by pattern.
+    uint16 key;
+    //! Bit N is set if the compound contains element N of the reaction
+    ElementMask elementMask;
+    //! True if the compound doesn't contain potential bonds
+    bool isStable;
+};
+
 class Reaction : public ObjectPool<Reaction, MAX_REACTIONS>
 {
 private:
     ElementSet elements;
-    LinkedList<Compound*, MAX_COMPOUNDS> possibleCompounds;
-    Compound* idealCompound = NULL;
+    //! The non-overlapping compounds chosen by Process, these are the compounds currently applied to the elements
+    CompoundSet idealCompounds;
 public:
     Reaction();
     ~Reaction();
@@ -20,12 +40,27 @@ public:
     ElementSet* Find(const char* symbol);
     void Add(Element* element);
 
+    //! Evaluates the reaction and applies its outcome, returns false if no compounds formed.
     bool Process();
+    //! Determines which compounds the reaction forms without applying them to the elements.
+    //! Evaluate only touches the elements of this reaction, so reactions that don't share elements can be evaluated at the same time.
+    void Evaluate();
+    //! Applies the compounds chosen by Evaluate to their elements, returns false if there aren't any
+    bool Apply();
+
+    //! Returns the elements of the reaction in the order they joined it
+    ElementSet* GetElements() { return &elements; }
+    //! Returns the compounds chosen by Evaluate
+    CompoundSet* GetIdealCompounds() { return &idealCompounds; }
 private:
-    Compound* StartNewCompound();
-    void CancelCompound(Compound* compound);
+    //! Adds the given compound found by the search to the candidates, or drops it if the candidates already have something at least as good.
+    void AddCandidate(CompoundCandidate* candidates, int* candidateCount, const CompoundCandidate* candidate);
+    //! Chooses the best combination of non-overlapping compounds from the candidates, and finds them again for idealCompounds.
+    void ChooseIdealCompounds(CompoundCandidate* candidates, int candidateCount, ReactionSnapshot* snapshot);
 
-public: // We meed these public for ReactionNode, but it might be nice to do it a different way.
-    void ClearElementMasks();
-    void ClearElementMasks(int bit);
+public:
+#ifdef REACTION_STATS
+    //! The work done for the pattern currently being processed, see ReactionStats
+    ReactionPatternStats patternStats;
+#endif
 };
@@ -0,0 +1,96 @@
+#include "ReactionCache.h"
+#include "ReactionOutcome.h"
+#include "Element.h"
+
+#include <sifteo.h>
+
+struct ReactionCacheEntry
+{
+    ReactionKey key;
+    //! The value of useCounter when this entry was last used, 0 if this entry is empty
+    uint32 lastUsed;
+
+    int compoundCount;
+    //! The outcome of the reaction, see ReactionOutcome
+    uint8 compoundOf[NUM_CUBES];
+    uint8 bondTypes[NUM_CUBES][BondSide_Count];
+    uint8 bondData[NUM_CUBES][BondSide_Count];
+};
+
+static ReactionCacheEntry entries[REACTION_CACHE_SIZE];
+static uint32 useCounter = 0;
+static uint32 hitCount = 0;
+static uint32 missCount = 0;
+PeriodicDeclareLock(lock);
+
+bool ReactionCache::Lookup(ElementSet* elements, CompoundSet* idealCompoundsOut)
+{
+    ReactionKey key;
+    key.Build(elements);
+
+    PeriodicLock(lock);
+    ReactionCacheEntry* entry = NULL;
+    for (int i = 0; i < REACTION_CACHE_SIZE; i++)
+    {
+        if (entries[i].lastUsed != 0 && entries[i].key.Equals(&key))
+        {
+            entry = &entries[i];
+            break;
+        }
+    }
+
+    if (entry == NULL)
+    {
+        missCount++;
+        PeriodicUnlock(lock);
+        return false;
+    }
+
+    hitCount++;
+    entry->lastUsed = ++useCounter;
+
+    ReactionOutcome::Restore(elements, entry->compoundCount, entry->compoundOf, entry->bondTypes, entry->bondData, idealCompoundsOut);
+    PeriodicUnlock(lock);
+    return true;
+}
+
+void ReactionCache::Store(ElementSet* elements, CompoundSet* idealCompounds)
+{
+    // Replace the least recently used entry:
+    PeriodicLock(lock);
+    ReactionCacheEntry* entry = &entries[0];
+    for (int i = 1; i < REACTION_CACHE_SIZE; i++)
+    {
+        if (entries[i].lastUsed < entry->lastUsed)
+        { entry = &entries[i]; }
+    }
+
+    entry->key.Build(elements);
+    entry->lastUsed = ++useCounter;
+    entry->compoundCount = ReactionOutcome::Save(elements, idealCompounds, entry->compoundOf, entry->bondTypes, entry->bondData);
+    PeriodicUnlock(lock);
+}
+
+void ReactionCache::Clear()
+{
+    PeriodicLock(lock);
+    PeriodicMemset(entries, 0, sizeof(entries));
+    useCounter = 0;
+    PeriodicUnlock(lock);
+}
+
+uint32 ReactionCache::GetHitCount()
+{
+    PeriodicLock(lock);
+    uint32 ret = hitCount;
+    PeriodicUnlock(lock);
+    return ret;
+}
+
+uint32 ReactionCache::GetMissCount()
+{
+    PeriodicLock(lock);
+    uint32 ret = missCount;
+    PeriodicUnlock(lock);
+    return ret;
+}
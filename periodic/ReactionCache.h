@@ -0,0 +1,35 @@
+#ifndef __REACTIONCACHE_H__
+#define __REACTIONCACHE_H__
+
+#include "periodic.h"
+#include "ElementSet.h"
+#include "CompoundSet.h"
+
+//! The number of reaction outcomes remembered by the ReactionCache
+#define REACTION_CACHE_SIZE 8
+
+//! Remembers the outcome of recently processed reactions so that rearranging the cubes back into a recent arrangement doesn't need to search
+//! the compound database again.
+//!
+//! Reactions are keyed by their ReactionKey, which holds exactly the information Reaction::Evaluate uses, so a cached outcome is always identical
+//! to the outcome of processing the reaction.
+//!
+//! The least recently used outcome is replaced when the cache is full.
+//! The cache is shared by all reactions, including ones processed at the same time on different threads in the standalone app.
+class ReactionCache
+{
+public:
+    //! Looks up the outcome of a reaction with the given elements. Returns false if it isn't cached.
+    //! On a hit, the ideal compounds are rebuilt from the cache and added to idealCompoundsOut with their bonds restored.
+    //! (None are added if the reaction doesn't form any compounds.)
+    static bool Lookup(ElementSet* elements, CompoundSet* idealCompoundsOut);
+    //! Remembers the ideal compounds chosen for a reaction with the given elements.
+    static void Store(ElementSet* elements, CompoundSet* idealCompounds);
+    //! Forgets all outcomes, this must be done whenever the compound database changes.
+    static void Clear();
+
+    static uint32 GetHitCount();
+    static uint32 GetMissCount();
+};
+
+#endif
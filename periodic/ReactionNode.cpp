@@ -0,0 +1,247 @@
+#include "ReactionNode.h"
+#include "ReactionSnapshot.h"
+#include "Reaction.h"
+#include "Element.h"
+#include "ReactionStats.h"
+
+//! The state of a node that is being processed by ReactionNode::Process.
+struct ReactionFrame
+{
+    const ReactionNode* node;
+    //! The child of the node that is being processed
+    const ReactionNode* child;
+    uint8 input;
+    //! The element the node's children are currently trying, REACTION_SNAPSHOT_NO_ELEMENT before the node has chosen one.
+    uint8 output;
+    //! The number of entries in the mark journal when the node started, the entries after it are the elements the node has marked.
+    int firstMark;
+    //! The used elements within reach of the node's subtree and the elements in use when the node started, used to record its failure.
+    ElementMask usedNearby;
+    ElementMask inUseBefore;
+};
+
+//! The steps ReactionNode::Process goes through for the frame on top of its stack
+enum ReactionStep
+{
+    ReactionStep_NextOutput, // Choose the next output for the node and start over with its first child
+    ReactionStep_NextChild, // Process the current child of the node, or finish the node if there are no more children
+    ReactionStep_Finish, // Finish the node and return its result to its parent
+    ReactionStep_ChildFinished // Continue the node now that its current child has finished with the result in success
+};
+
+//! Returns the first node after the given node's subtree, which is its next sibling if it has one.
+static const ReactionNode* SkipSubtree(const ReactionNode* node, const ReactionNode* end)
+{
+    const ReactionNode* ret = node + 1;
+    while (ret < end && ret->depth > node->depth)
+    { ret++; }
+    return ret;
+}
+
+bool ReactionNode::Process(const ReactionNode* end, Reaction* reaction, ReactionSnapshot* snapshot, Compound* compound, int input, int* nodesReached) const
+{
+    // Patterns are processed by walking their nodes in order with an explicit stack of the nodes being processed rather than recursing.
+    // Each node is retried with a different output until all of its children succeed with it (or the first child of an EitherOr does.)
+    ReactionFrame stack[MAX_REACTION_DEPTH];
+    int top = 0;
+    stack[0].node = this;
+    stack[0].input = (uint8)input;
+    stack[0].output = REACTION_SNAPSHOT_NO_ELEMENT;
+    stack[0].firstMark = 0;
+
+    // Every element a node marks with its depth is recorded in this journal, so that finishing a node only has to clear the marks it made.
+    // Nodes only output elements that aren't marked at all, except for pass-through nodes which mark their input once, so this can't overflow.
+    uint8 marks[NUM_CUBES + MAX_REACTION_DEPTH];
+    int markCount = 0;
+
+    ReactionStep step = ReactionStep_NextOutput;
+    bool success = false; // The result of the most recently finished node
+    const ReactionNode* furthest = this; // Nodes are started in pre-order, so this is the last node that was started
+
+    // A subtree can't reach further from its input than one bond past the deepest node of the pattern:
+    int deepestDepth = 0;
+    for (const ReactionNode* node = this; node < end; node++)
+    {
+        if (node->depth > deepestDepth)
+        { deepestDepth = node->depth; }
+    }
+    ReactionStatsCount(reaction, nodesVisited);
+
+    while (true)
+    {
+        ReactionFrame* frame = &stack[top];
+        const ReactionNode* node = frame->node;
+        //LOG("%s:0x%X.Process(Compound:0x%X, Element:%d, %d)\n", node->GetDescription(), node, compound, frame->input, node->depth);
+        Assert(node->depth < MAX_REACTION_DEPTH);
+
+        switch (step)
+        {
+        case ReactionStep_NextOutput:
+        {
+            // This will return a different element each time it is called, and REACTION_SNAPSHOT_NO_ELEMENT when no element is available
+            // Therefore, we can loop until we find an element with child elements that satisfy this branch of the reaction.
+            uint8 lastOutput = frame->output;
+            frame->output = (uint8)node->GetOutput(snapshot, frame->input);
+            ReactionStatsCount(reaction, outputCalls);
+
+            // If there's no output, we ran out of possibilities and failed.
+            // If output == lastOutput, then this is a pass-through node. Either way we want to not loop forever.
+            if (frame->output == REACTION_SNAPSHOT_NO_ELEMENT || frame->output == lastOutput)
+            {
+                success = false;
+                step = ReactionStep_Finish;
+                break;
+            }
+
+            // Mark this element as being used for this depth of the compound processing
+            Assert(markCount < (int)CountOfArray(marks));
+            snapshot->UseAtDepth(frame->output, node->depth);
+            marks[markCount++] = frame->output;
+
+            // Children immediately follow their parent, one level deeper.
+            frame->child = node + 1;
+            step = ReactionStep_NextChild;
+            break;
+        }
+        case ReactionStep_NextChild:
+            if (frame->child >= end || frame->child->depth <= node->depth)
+            {
+                // If we got this far, either all children met their criteria or no branch of an EitherOr did. (In which case we try the next output.)
+                if (node->type == ReactionNodeType_EitherOr)
+                { step = ReactionStep_NextOutput; }
+                else
+                {
+                    success = true;
+                    step = ReactionStep_Finish;
+                }
+                break;
+            }
+
+            // Process the child (on the next depth) with our output as its input:
+            Assert(frame->child->depth == node->depth + 1);
+            Assert(top + 1 < MAX_REACTION_DEPTH);
+            {
+                ElementMask usedNearby = snapshot->GetUsedNearby(frame->output, deepestDepth - frame->child->depth + 1);
+                ReactionFailure* failure = snapshot->FindFailure(frame->child->GetTwin(), frame->output, usedNearby);
+                if (failure != NULL)
+                {
+                    // The child already failed in this situation, so skip straight to its result:
+                    if (failure->markedInput)
+                    { snapshot->SetInUse(frame->output); }
+
+                    const ReactionNode* last = SkipSubtree(frame->child, end) - 1;
+                    if (last > furthest)
+                    { furthest = last; } // Count the subtree as reached, since it was the last time it failed.
+
+                    success = false;
+                    step = ReactionStep_ChildFinished;
+                    break;
+                }
+
+                top++;
+                stack[top].node = frame->child;
+                stack[top].input = frame->output;
+                stack[top].output = REACTION_SNAPSHOT_NO_ELEMENT;
+                stack[top].firstMark = markCount;
+                stack[top].usedNearby = usedNearby;
+                stack[top].inUseBefore = snapshot->inUseElements;
+                if (frame->child > furthest)
+                { furthest = frame->child; }
+                step = ReactionStep_NextOutput;
+                ReactionStatsCount(reaction, nodesVisited);
+            }
+            break;
+        case ReactionStep_Finish:
+            // Clear all of the elements we considered for this branch: (Our children have already cleared theirs, so the rest of the journal is ours.)
+            for (; markCount > frame->firstMark; markCount--)
+            { snapshot->StopUsingAtDepth(marks[markCount - 1], node->depth); }
+            ReactionStatsCount(reaction, masksCleared);
+
+            if (success)
+            { node->ApplyBond(snapshot, compound, frame->input, frame->output); }
+
+            if (top == 0)
+            {
+                if (nodesReached != NULL)
+                { *nodesReached = (int)(furthest - this) + 1; }
+                return success;
+            }
+
+            // Remember the failure if skipping it next time can't change anything: (Any other element it put in use could be part of the compound.)
+            if (!success && (snapshot->inUseElements & ~frame->inUseBefore & ~ElementMaskBit(frame->input)) == 0)
+            { snapshot->RecordFailure(node->GetTwin(), frame->input, frame->usedNearby, !!(snapshot->inUseElements & ~frame->inUseBefore)); }
+
+            // Return the result to the parent:
+            top--;
+            step = ReactionStep_ChildFinished;
+            break;
+        case ReactionStep_ChildFinished:
+            if (node->type == ReactionNodeType_EitherOr && success)
+            { step = ReactionStep_Finish; } // An EitherOr node succeeds when its first child succeeds.
+            else if (node->type != ReactionNodeType_EitherOr && !success)
+            {
+                step = ReactionStep_NextOutput; // All children must succeed, so try the next output.
+                ReactionStatsCount(reaction, backtracks);
+            }
+            else
+            {
+                frame->child = SkipSubtree(frame->child, end);
+                step = ReactionStep_NextChild;
+            }
+            break;
+        }
+    }
+}
+
+int ReactionNode::GetOutput(ReactionSnapshot* snapshot, int input) const
+{
+    switch (type)
+    {
+    case ReactionNodeType_ElementSymbolFilter:
+        return snapshot->atomicNumbers[input] == atomicNumber ? input : REACTION_SNAPSHOT_NO_ELEMENT;
+    case ReactionNodeType_ElementSymbol:
+        return snapshot->FindNeighbor(input, snapshot->neighborAtomicNumbers[input], atomicNumber);
+    case ReactionNodeType_ElementGroupFilter:
+        return snapshot->groups[input] == group ? input : REACTION_SNAPSHOT_NO_ELEMENT;
+    case ReactionNodeType_ElementGroup:
+        return snapshot->FindNeighbor(input, snapshot->neighborGroups[input], group);
+    case ReactionNodeType_EitherOr:
+    case ReactionNodeType_NoOp:
+        return input; // These nodes are pure pass-through nodes
+    default:
+        LOG("WARN: Called GetOutput on invalid ReactionNode:0x%X with Element:%d as input @ depth %d!\n", this, input, depth);
+        return REACTION_SNAPSHOT_NO_ELEMENT;
+    }
+}
+
+void ReactionNode::ApplyBond(ReactionSnapshot* snapshot, Compound* compound, int left, int right) const
+{
+    // We need to mark the elements as in use even if no bond needs to be added.
+    snapshot->SetInUse(left);
+    snapshot->SetInUse(right);
+
+    if (bondType == BondType_None)
+    { return; }
+
+    //LOG("ApplyBond(Compound:0x%X, Element:%d, Element:%d)\n", compound, left, right);
+    Assert(left != right); // This means a bond was applied to a passthrough node.
+
+    snapshot->RecordBond(left, right, (BondType)bondType);
+    if (compound == NULL)
+    { return; } // The search is only looking for candidates, see Reaction::Evaluate.
+    snapshot->elements[left]->SetBondTypeFor(compound, snapshot->elements[right], (BondType)bondType, bondLeftData, bondRightData);
+}
+
+const char* ReactionNode::GetDescription() const
+{
+    switch (type)
+    {
+    case ReactionNodeType_ElementSymbolFilter: return "ElementSymbolFilterNode";
+    case ReactionNodeType_ElementSymbol: return "ElementSymbolNode";
+    case ReactionNodeType_ElementGroupFilter: return "ElementGroupFilterNode";
+    case ReactionNodeType_ElementGroup: return "ElementGroupNode";
+    case ReactionNodeType_EitherOr: return "EitherOrNode";
+    case ReactionNodeType_NoOp: return "NoOpNode";
+    default: return "ReactionNode";
+    }
+}
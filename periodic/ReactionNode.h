@@ -0,0 +1,91 @@
+#ifndef __REACTIONNODE_H__
+#define __REACTIONNODE_H__
+
+#include "periodic.h"
+#include "Element.h"
+#include "Bond.h"
+
+class Compound;
+class Reaction;
+struct ReactionSnapshot;
+
+//! The number of depths the reaction search has room for, which bounds the depth of the patterns in the compound database.
+#ifdef STANDALONE_APP
+// The standalone app loads compound databases at runtime, so it has room for every depth a node can record.
+#define MAX_REACTION_DEPTH 256
+#else
+// The device only uses the embedded compound database, so the search is sized for its deepest pattern.
+#include "compounds.gen.h"
+#define MAX_REACTION_DEPTH (COMPOUNDS_MAX_DEPTH + 1)
+#endif
+
+//! Used for the group of nodes which don't have a group.
+#define REACTION_NODE_NO_GROUP 0xFF
+
+enum ReactionNodeType
+{
+    ReactionNodeType_ElementSymbolFilter, // Passes the input through if it has a specific symbol
+    ReactionNodeType_ElementSymbol, // Outputs an unused neighbor of the input with a specific symbol
+    ReactionNodeType_ElementGroupFilter, // Passes the input through if it belongs to a specific group
+    ReactionNodeType_ElementGroup, // Outputs an unused neighbor of the input from a specific group
+    ReactionNodeType_EitherOr, // Passes the input through, only one branch of children needs to succeed
+    ReactionNodeType_NoOp, // Passes the input through, used for coalescing common elements after an EitherOr
+    ReactionNodeType_Count
+};
+
+//! A single node of a pattern in the compound database.
+//! Patterns are flat, read-only arrays of nodes listed in pre-order, the children of a node are the nodes that follow it one level deeper.
+//! A node's input is the element chosen by its parent, and its output is the element its children get as their input.
+//! This is the exact layout of a node record in a compiled compound database image (see CompoundGen), so it must only contain bytes.
+struct ReactionNode
+{
+    //! A ReactionNodeType
+    uint8 type;
+    //! How far below the root of its pattern this node is, also used to track the elements it considers.
+    uint8 depth;
+    //! The BondType this node forms between its input and its output when it succeeds.
+    uint8 bondType;
+    uint8 bondLeftData;
+    uint8 bondRightData;
+    //! The groupState used by group nodes, REACTION_NODE_NO_GROUP otherwise.
+    uint8 group;
+    //! The atomic number of the element used by symbol nodes, 0 otherwise. (CompoundGen interns symbols so they never need to be compared as strings.)
+    uint8 atomicNumber;
+    //! How many nodes before this one its twin is, 0 if it doesn't have one. (See GetTwin.)
+    uint8 twinOffset;
+
+    //! Tries to satisfy this node and all of its children with the given input, applying bonds to the compound on success.
+    //! end must point just past the last node of this node's pattern, and input is the index of an element in the given snapshot of the reaction.
+    //! compound may be NULL, in which case the bonds are only recorded in the snapshot. (See ReactionSnapshot::RecordBond.)
+    //! The nodes are interpreted in a single loop with an explicit stack rather than by recursing through every level of the pattern.
+    //! All of the state of the search is either on that stack or part of the snapshot, so reactions can be processed at the same time.
+    //! If nodesReached isn't NULL, it receives the number of nodes from this one up to the furthest node the search started processing.
+    bool Process(const ReactionNode* end, Reaction* reaction, ReactionSnapshot* snapshot, Compound* compound, int input, int* nodesReached) const;
+
+    //! Returns the first of this node's earlier siblings that has the same subtree as it (ignoring bonds), or this node if there isn't one.
+    //! Twins are interchangeable as far as the search is concerned, so they share their entries in the failure memo. (See ReactionSnapshot.)
+    //! CompoundGen finds the twins, like the oxygens of PerchloricAcid or the halogens of AlkaliEarth_2Halogen.
+    const ReactionNode* GetTwin() const { return this - twinOffset; }
+
+    //! Returns true if this node only passes its input through to its children.
+    bool IsPassThrough() const
+    {
+        return type == ReactionNodeType_ElementSymbolFilter || type == ReactionNodeType_ElementGroupFilter || type == ReactionNodeType_EitherOr || type == ReactionNodeType_NoOp;
+    }
+
+    //! Returns true if the given element is the element used by this (symbol) node.
+    bool MatchesElement(Element* element) const
+    {
+        return element->GetAtomicNumber() == atomicNumber;
+    }
+
+    const char* GetDescription() const;
+private:
+    //! Returns a different element each time it is called for the same input, and REACTION_SNAPSHOT_NO_ELEMENT when no element is available.
+    int GetOutput(ReactionSnapshot* snapshot, int input) const;
+    void ApplyBond(ReactionSnapshot* snapshot, Compound* compound, int left, int right) const;
+};
+
+CompilerAssert(sizeof(ReactionNode) == 8);
+
+#endif
@@ -0,0 +1,109 @@
+#include "ReactionOutcome.h"
+#include "Element.h"
+#include "Compound.h"
+
+#include <sifteo.h>
+
+//------------------------------------------------------------------------------
+// ReactionKey
+//------------------------------------------------------------------------------
+void ReactionKey::Build(ElementSet* elements)
+{
+    elementCount = elements->Count();
+    hash = 2166136261u; // FNV-1a
+
+    uint8* keyData = data;
+    for (int i = 0; i < elements->Count(); i++)
+    {
+        Element* element = elements->Get(i);
+        *(keyData++) = (uint8)element->GetRawElementNum();
+
+        for (int side = 0; side < BondSide_Count; side++)
+        {
+            Element* neighbor = element->GetBondWith((BondSide)side);
+            int neighborIndex = neighbor == NULL ? REACTION_KEY_NO_NEIGHBOR : elements->IndexOf(neighbor);
+            Assert(neighborIndex >= 0); // All neighbors must be part of the same reaction.
+            *(keyData++) = (uint8)neighborIndex;
+        }
+    }
+
+    for (int i = 0; i < GetSize(); i++)
+    {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+}
+
+bool ReactionKey::Equals(ReactionKey* other)
+{
+    if (hash != other->hash || elementCount != other->elementCount)
+    { return false; }
+
+    for (int i = 0; i < GetSize(); i++)
+    {
+        if (data[i] != other->data[i])
+        { return false; }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// ReactionOutcome
+//------------------------------------------------------------------------------
+int ReactionOutcome::Save(ElementSet* elements, CompoundSet* idealCompounds, uint8* compoundOf, uint8 (*bondTypes)[BondSide_Count],
+    uint8 (*bondData)[BondSide_Count])
+{
+    PeriodicMemset(compoundOf, REACTION_OUTCOME_NO_COMPOUND, elements->Count());
+    PeriodicMemset(bondTypes, 0, elements->Count() * sizeof(*bondTypes));
+    PeriodicMemset(bondData, 0, elements->Count() * sizeof(*bondData));
+
+    for (int c = 0; c < idealCompounds->Count(); c++)
+    {
+        Compound* compound = idealCompounds->Get(c);
+        for (int i = 0; i < elements->Count(); i++)
+        {
+            Element* element = elements->Get(i);
+            if (!compound->ContainsElement(element))
+            { continue; }
+
+            Assert(compoundOf[i] == REACTION_OUTCOME_NO_COMPOUND); // Ideal compounds never overlap.
+            compoundOf[i] = (uint8)c;
+            for (int side = 0; side < BondSide_Count; side++)
+            {
+                int data = element->GetBondDataFor(compound, (BondSide)side);
+                Assert(data >= 0 && data <= 0xFF);
+                bondTypes[i][side] = (uint8)element->GetBondTypeFor(compound, (BondSide)side);
+                bondData[i][side] = (uint8)data;
+            }
+        }
+    }
+
+    return idealCompounds->Count();
+}
+
+void ReactionOutcome::Restore(ElementSet* elements, int compoundCount, const uint8* compoundOf, const uint8 (*bondTypes)[BondSide_Count],
+    const uint8 (*bondData)[BondSide_Count], CompoundSet* idealCompoundsOut)
+{
+    // The ideal compounds are the only compounds left in the reaction after processing, so they can always use the first indices.
+    for (int c = 0; c < compoundCount; c++)
+    {
+        Compound* compound = new Compound(c);
+        for (int i = 0; i < elements->Count(); i++)
+        {
+            if (compoundOf[i] != c)
+            { continue; }
+
+            Element* element = elements->Get(i);
+            compound->AddElement(element);
+
+            for (int side = 0; side < BondSide_Count; side++)
+            {
+                if (bondTypes[i][side] != BondType_None || bondData[i][side] != 0)
+                { element->SetOneSidedBondTypeFor(compound, (BondSide)side, (BondType)bondTypes[i][side], bondData[i][side]); }
+            }
+        }
+
+        idealCompoundsOut->Add(compound);
+    }
+}
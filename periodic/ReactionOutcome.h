@@ -0,0 +1,54 @@
+#ifndef __REACTIONOUTCOME_H__
+#define __REACTIONOUTCOME_H__
+
+#include "periodic.h"
+#include "ElementSet.h"
+#include "CompoundSet.h"
+#include "Bond.h"
+
+//! Marks a side of an element in a ReactionKey that doesn't have a neighbor
+#define REACTION_KEY_NO_NEIGHBOR 0xFF
+//! Marks an element in a ReactionOutcome that isn't part of any compound
+#define REACTION_OUTCOME_NO_COMPOUND 0xFF
+//! The number of bytes each element takes up in ReactionKey::data
+#define REACTION_KEY_BYTES_PER_ELEMENT (1 + BondSide_Count)
+
+//! Identifies the arrangement of the elements in a reaction, used to look up outcomes that were determined ahead of time.
+//!
+//! Reactions are keyed by the raw element of each element in the reaction (in reaction order) and the index of the element on each of its sides.
+//! The bond sides are already relative to the first cube in the reaction (see SetCubeRotation), so the key doesn't depend on how the whole
+//! arrangement is rotated or where it sits. It does depend on the cube IDs though: The reaction starts from its cube with the lowest ID and adds
+//! the rest in the order a depth-first walk from it finds them, so the same arrangement built from different cubes can have a different key.
+//! Since this is exactly the information Reaction::Evaluate uses, reactions with the same key always have the same outcome.
+struct ReactionKey
+{
+    int elementCount;
+    //! For each element: Its raw element number followed by the index of the element on each of its sides (or REACTION_KEY_NO_NEIGHBOR)
+    uint8 data[NUM_CUBES * REACTION_KEY_BYTES_PER_ELEMENT];
+    //! FNV-1a hash of the used part of data
+    uint32 hash;
+
+    void Build(ElementSet* elements);
+    bool Equals(ReactionKey* other);
+    int GetSize() { return elementCount * REACTION_KEY_BYTES_PER_ELEMENT; }
+};
+
+//! Converts the ideal compounds of a reaction to and from a compact form that only refers to elements by their index in the reaction.
+//! Used by the ReactionCache and the OutcomeTable to remember outcomes.
+//!
+//! An outcome is described by the index of the ideal compound each element is part of (or REACTION_OUTCOME_NO_COMPOUND), along with the bond type
+//! and bond data of each element for its compound.
+class ReactionOutcome
+{
+public:
+    //! Records the given ideal compounds of a reaction with the given elements, returns the number of compounds.
+    static int Save(ElementSet* elements, CompoundSet* idealCompounds, uint8* compoundOf, uint8 (*bondTypes)[BondSide_Count],
+        uint8 (*bondData)[BondSide_Count]);
+    //! Rebuilds the ideal compounds of a reaction with the given elements and adds them to idealCompoundsOut with their bonds restored.
+    static void Restore(ElementSet* elements, int compoundCount, const uint8* compoundOf, const uint8 (*bondTypes)[BondSide_Count],
+        const uint8 (*bondData)[BondSide_Count], CompoundSet* idealCompoundsOut);
+};
+CompilerAssert(MAX_COMPOUNDS < REACTION_OUTCOME_NO_COMPOUND);
+CompilerAssert(NUM_CUBES < REACTION_KEY_NO_NEIGHBOR);
+
+#endif
@@ -0,0 +1,86 @@
+#include "ReactionSnapshot.h"
+#include "ReactionNode.h"
+#include "Element.h"
+
+void ReactionSnapshot::Build(ElementSet* elements)
+{
+    elementCount = elements->Count();
+    for (int i = 0; i < elementCount; i++)
+    {
+        Element* element = elements->Get(i);
+        this->elements[i] = element;
+        atomicNumbers[i] = (uint8)element->GetAtomicNumber();
+        groups[i] = (uint8)element->GetGroup();
+    }
+
+    for (int i = 0; i < elementCount; i++)
+    {
+        neighborAtomicNumbers[i] = 0;
+        neighborGroups[i] = 0;
+        neighborCounts[i] = 0;
+        neighborGroupCounts[i] = 0;
+
+        for (int side = 0; side < BondSide_Count; side++)
+        {
+            Element* neighbor = this->elements[i]->GetBondWith((BondSide)side);
+            int neighborIndex = neighbor == NULL ? REACTION_SNAPSHOT_NO_ELEMENT : elements->IndexOf(neighbor);
+            Assert(neighborIndex >= 0); // All neighbors must be part of the same reaction.
+            neighbors[i][side] = (uint8)neighborIndex;
+
+            uint32 atomicNumber = neighbor == NULL ? 0 : atomicNumbers[neighborIndex];
+            uint32 group = neighbor == NULL ? REACTION_NODE_NO_GROUP : groups[neighborIndex];
+            neighborAtomicNumbers[i] |= atomicNumber << (side * 8);
+            neighborGroups[i] |= group << (side * 8);
+
+            if (neighbor != NULL)
+            {
+                neighborCounts[i]++;
+                neighborGroupCounts[i] += 1 << (group * 4);
+            }
+        }
+    }
+
+    // Find the elements near each element by adding the neighbors of the elements one bond closer, until there's nothing left to add:
+    ElementMask neighborMasks[NUM_CUBES];
+    for (int i = 0; i < elementCount; i++)
+    {
+        neighborMasks[i] = 0;
+        for (int side = 0; side < BondSide_Count; side++)
+        {
+            if (neighbors[i][side] != REACTION_SNAPSHOT_NO_ELEMENT)
+            { neighborMasks[i] |= ElementMaskBit(neighbors[i][side]); }
+        }
+    }
+
+    for (int i = 0; i < elementCount; i++)
+    {
+        ElementMask nearby = ElementMaskBit(i);
+        nearbyElements[i][0] = nearby;
+        for (int distance = 1; distance <= REACTION_SNAPSHOT_MAX_DISTANCE; distance++)
+        {
+            ElementMask grown = nearby;
+            for (ElementMask remaining = nearby; remaining != 0; remaining &= remaining - 1)
+            {
+                int j = 0;
+                for (; !(remaining & ElementMaskBit(j)); j++) { }
+                grown |= neighborMasks[j];
+            }
+
+            nearbyElements[i][distance] = grown;
+            if (grown == nearby)
+            {
+                for (distance++; distance <= REACTION_SNAPSHOT_MAX_DISTANCE; distance++)
+                { nearbyElements[i][distance] = grown; }
+            }
+            nearby = grown;
+        }
+    }
+
+    PeriodicMemset(depthElements, 0, sizeof(depthElements));
+    PeriodicMemset(depthCounts, 0, sizeof(depthCounts));
+    busyElements = 0;
+    inUseElements = 0;
+    bondedElements = 0;
+    hasPotentialBonds = false;
+    PeriodicMemset(failures, 0, sizeof(failures)); // Failures are only valid for the reaction they happened in
+}
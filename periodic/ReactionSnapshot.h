@@ -0,0 +1,199 @@
+#ifndef __REACTIONSNAPSHOT_H__
+#define __REACTIONSNAPSHOT_H__
+
+#include "periodic.h"
+#include "ElementSet.h"
+#include "Bond.h"
+#include "ReactionNode.h"
+
+class Element;
+
+//! Marks a missing element in a ReactionSnapshot, used for sides without a neighbor and for nodes that haven't chosen an output.
+#define REACTION_SNAPSHOT_NO_ELEMENT 0xFF
+//! The farthest two elements of a reaction can be from each other, counted in bonds.
+#define REACTION_SNAPSHOT_MAX_DISTANCE (NUM_CUBES - 1)
+//! The number of failed subtrees a ReactionSnapshot remembers, must be a power of two.
+#define REACTION_FAILURE_MEMO_SIZE 32
+
+//! A subtree of a pattern that failed to match, see ReactionSnapshot::FindFailure.
+struct ReactionFailure
+{
+    //! The root of the subtree, or rather its twin (see ReactionNode::GetTwin), NULL for unused entries
+    const ReactionNode* node;
+    //! The elements within reach of the subtree that were used when it was processed
+    ElementMask usedNearby;
+    //! The input of the subtree's root
+    uint8 input;
+    //! True if the subtree marked its input as in use before it failed
+    bool markedInput;
+};
+
+//! A dense copy of everything the reaction search looks at, taken by Reaction::Evaluate before it searches the compound database.
+//!
+//! Elements are referred to by their index in the reaction, and each property is kept in its own array so the search never has to chase pointers
+//! through the (much larger) Element objects. The properties of the neighbors on each side of an element are also packed into a 32 bit word (one
+//! byte per side, in BondSide order), so a node can compare all four sides of its input at once. (See FindNeighbor.)
+//!
+//! The snapshot also tracks which elements the search is using: An element is used at a depth while the node at that depth has chosen it, and it is
+//! in use once it is part of the compound being built. The search only outputs elements that aren't used at all.
+struct ReactionSnapshot
+{
+    int elementCount;
+    //! The elements of the reaction, in reaction order
+    Element* elements[NUM_CUBES];
+    uint8 atomicNumbers[NUM_CUBES];
+    //! The groupState of each element
+    uint8 groups[NUM_CUBES];
+    //! The index of the element on each side of each element, or REACTION_SNAPSHOT_NO_ELEMENT
+    uint8 neighbors[NUM_CUBES][BondSide_Count];
+    //! The atomic number of the element on each side of each element (0 for none), packed one byte per side
+    uint32 neighborAtomicNumbers[NUM_CUBES];
+    //! The group of the element on each side of each element (REACTION_NODE_NO_GROUP for none), packed one byte per side
+    uint32 neighborGroups[NUM_CUBES];
+    //! The number of neighbors of each element
+    uint8 neighborCounts[NUM_CUBES];
+    //! The number of neighbors of each element from each group, 4 bits per groupState (See CompoundDatabase::HasRootNeighbors.)
+    uint32 neighborGroupCounts[NUM_CUBES];
+
+    //! Bit M of entry [N][D] is set if element M is at most D bonds away from element N
+    ElementMask nearbyElements[NUM_CUBES][REACTION_SNAPSHOT_MAX_DISTANCE + 1];
+
+    //! Bit N of entry D is set while the node at depth D is using element N
+    ElementMask depthElements[MAX_REACTION_DEPTH];
+    //! The number of depths each element is being used at
+    uint8 depthCounts[NUM_CUBES];
+    //! Bit N is set while element N is being used at any depth
+    ElementMask busyElements;
+    //! Bit N is set once element N is part of the compound being built
+    ElementMask inUseElements;
+    //! Bit N is set once element N has a bond in the compound being built, which is the set of elements the compound ends up with
+    ElementMask bondedElements;
+    //! True once the compound being built has a potential bond
+    bool hasPotentialBonds;
+
+    //! Subtrees that failed during this reaction, indexed by a hash of their key
+    ReactionFailure failures[REACTION_FAILURE_MEMO_SIZE];
+
+    void Build(ElementSet* elements);
+
+    //! Marks every element as not in use for a new compound.
+    //! The search for the previous compound stopped using every element at every depth before it returned, so this doesn't need to visit them.
+    void StartCompound()
+    {
+        Assert(busyElements == 0);
+        inUseElements = 0;
+        bondedElements = 0;
+        hasPotentialBonds = false;
+    }
+
+    bool IsUsed(int element) { return !!((busyElements | inUseElements) & ElementMaskBit(element)); }
+    //! Records a bond of the compound being built, so the compound can be compared with others without looking at it. (See Reaction::AddCandidate.)
+    void RecordBond(int left, int right, BondType type)
+    {
+        bondedElements |= ElementMaskBit(left) | ElementMaskBit(right);
+        hasPotentialBonds |= type == BondType_Potential;
+    }
+    //! Returns the elements at most the given number of bonds away from the given element which are used.
+    ElementMask GetUsedNearby(int element, int distance)
+    {
+        if (distance > REACTION_SNAPSHOT_MAX_DISTANCE)
+        { distance = REACTION_SNAPSHOT_MAX_DISTANCE; }
+        return (busyElements | inUseElements) & nearbyElements[element][distance];
+    }
+    void SetInUse(int element) { inUseElements |= ElementMaskBit(element); }
+
+    void UseAtDepth(int element, int depth)
+    {
+        Assert(depth >= 0 && depth < MAX_REACTION_DEPTH);
+        ElementMask bit = ElementMaskBit(element);
+        if (depthElements[depth] & bit)
+        { return; }
+
+        depthElements[depth] |= bit;
+        if (depthCounts[element]++ == 0)
+        { busyElements |= bit; }
+    }
+
+    void StopUsingAtDepth(int element, int depth)
+    {
+        Assert(depth >= 0 && depth < MAX_REACTION_DEPTH);
+        ElementMask bit = ElementMaskBit(element);
+        if (!(depthElements[depth] & bit))
+        { return; }
+
+        depthElements[depth] &= ~bit;
+        if (--depthCounts[element] == 0)
+        { busyElements &= ~bit; }
+    }
+
+    //! Returns the recorded failure of the given subtree with the given input and used elements near it, or NULL if it hasn't failed like this.
+    //!
+    //! A subtree of a pattern only looks at elements a limited number of bonds away from its input, and the only thing it looks at in them is whether
+    //! they're used. (Nothing else in the snapshot changes during a search, and nodes deeper than the subtree's root have no elements marked when it
+    //! starts.) So a subtree that failed will fail again whenever it gets the same input with the same used elements within its reach.
+    //! Only failures that had no effect besides marking their input as in use are recorded, so skipping one never changes the compound being built.
+    ReactionFailure* FindFailure(const ReactionNode* node, int input, ElementMask usedNearby)
+    {
+        ReactionFailure* failure = &failures[HashFailure(node, input, usedNearby)];
+        return failure->node == node && failure->input == input && failure->usedNearby == usedNearby ? failure : NULL;
+    }
+
+    //! Records the failure of the given subtree, replacing whichever failure shared its slot.
+    void RecordFailure(const ReactionNode* node, int input, ElementMask usedNearby, bool markedInput)
+    {
+        ReactionFailure* failure = &failures[HashFailure(node, input, usedNearby)];
+        failure->node = node;
+        failure->usedNearby = usedNearby;
+        failure->input = (uint8)input;
+        failure->markedInput = markedInput;
+    }
+
+    static int HashFailure(const ReactionNode* node, int input, ElementMask usedNearby)
+    {
+        uint32 hash = (uint32)(size_t)node / sizeof(ReactionNode) + input * 7 + usedNearby * 13;
+        return (int)((hash ^ (hash >> 5)) & (REACTION_FAILURE_MEMO_SIZE - 1));
+    }
+
+    //! Returns the packed neighbor properties with the high bit set in exactly the bytes that are value.
+    static uint32 MatchNeighbors(uint32 packedNeighborProperties, uint8 value)
+    {
+        // Bytes of difference are zero where the neighbor has the value:
+        uint32 difference = packedNeighborProperties ^ (value * 0x01010101u);
+        return ~(((difference & 0x7F7F7F7Fu) + 0x7F7F7F7Fu) | difference | 0x7F7F7F7Fu);
+    }
+
+    //! Returns the number of neighbors (used or not) whose byte in the given packed neighbor properties is value.
+    //! Like FindNeighbor, value must not match the filler used for missing neighbors.
+    static int CountNeighbors(uint32 packedNeighborProperties, uint8 value)
+    {
+        // Move each match down to the lowest bit of its byte, then the multiplication adds up every byte in the top byte:
+        return (int)(((MatchNeighbors(packedNeighborProperties, value) >> 7) * 0x01010101u) >> 24);
+    }
+
+    //! Returns the first unused neighbor of the given element (in BondSide order) whose byte in the given packed neighbor properties is value,
+    //! or REACTION_SNAPSHOT_NO_ELEMENT if there isn't one.
+    int FindNeighbor(int element, uint32 packedNeighborProperties, uint8 value)
+    {
+        uint32 matches = MatchNeighbors(packedNeighborProperties, value);
+
+        for (int side = 0; matches != 0; side++, matches >>= 8)
+        {
+            if (!(matches & 0x80))
+            { continue; }
+
+            int neighbor = neighbors[element][side];
+            Assert(neighbor != REACTION_SNAPSHOT_NO_ELEMENT); // Values must not match the filler used for missing neighbors.
+            if (!IsUsed(neighbor))
+            { return neighbor; }
+        }
+
+        return REACTION_SNAPSHOT_NO_ELEMENT;
+    }
+};
+
+CompilerAssert(NUM_CUBES < REACTION_SNAPSHOT_NO_ELEMENT);
+CompilerAssert(BondSide_Count == sizeof(uint32));
+CompilerAssert((REACTION_FAILURE_MEMO_SIZE & (REACTION_FAILURE_MEMO_SIZE - 1)) == 0);
+CompilerAssert(MAX_REACTION_DEPTH <= 0xFF + 1); // An element can't be used at more depths than depthCounts can count.
+
+#endif
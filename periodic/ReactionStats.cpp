@@ -0,0 +1,128 @@
+#include "ReactionStats.h"
+#include "CompoundDatabase.h"
+#include "Reaction.h"
+
+#include <sifteo.h>
+
+#ifdef REACTION_STATS
+static ReactionPatternStats patternStats[MAX_DATABASE_PATTERNS];
+static uint32 searchCount = 0;
+PeriodicDeclareLock(lock);
+
+static uint32 GetMicroseconds()
+{
+    return (uint32)Sifteo::SystemTime::now().uptimeUS();
+}
+
+void ReactionStats::BeginPattern(Reaction* reaction)
+{
+    PeriodicMemset(&reaction->patternStats, 0, sizeof(reaction->patternStats));
+    reaction->patternStats.microseconds = GetMicroseconds();
+}
+
+void ReactionStats::EndPattern(Reaction* reaction, int pattern)
+{
+    ReactionPatternStats* counters = &reaction->patternStats;
+    counters->microseconds = GetMicroseconds() - counters->microseconds;
+
+    PeriodicLock(lock);
+    ReactionPatternStats* stats = GetPatternStats(pattern);
+    stats->nodesVisited += counters->nodesVisited;
+    stats->outputCalls += counters->outputCalls;
+    stats->backtracks += counters->backtracks;
+    stats->masksCleared += counters->masksCleared;
+    stats->patternsTried += counters->patternsTried;
+    stats->patternsFailed += counters->patternsFailed;
+    stats->microseconds += counters->microseconds;
+    PeriodicUnlock(lock);
+}
+
+void ReactionStats::EndSearch()
+{
+    PeriodicLock(lock);
+    searchCount++;
+    PeriodicUnlock(lock);
+
+#ifndef STANDALONE_APP
+    if (searchCount % REACTION_STATS_LOG_INTERVAL == 0)
+    { Log(); }
+#endif
+}
+
+void ReactionStats::Reset()
+{
+    PeriodicLock(lock);
+    PeriodicMemset(patternStats, 0, sizeof(patternStats));
+    searchCount = 0;
+    PeriodicUnlock(lock);
+}
+
+ReactionPatternStats* ReactionStats::GetPatternStats(int pattern)
+{
+    Assert(pattern >= 0 && pattern < MAX_DATABASE_PATTERNS);
+    return &patternStats[pattern];
+}
+
+uint32 ReactionStats::GetSearchCount()
+{
+    PeriodicLock(lock);
+    uint32 ret = searchCount;
+    PeriodicUnlock(lock);
+    return ret;
+}
+
+void ReactionStats::Log()
+{
+    PeriodicLock(lock);
+    LOG("Reaction statistics after %d searches:\n", searchCount);
+    for (int i = 0; i < CompoundDatabase::GetPatternCount(); i++)
+    {
+        ReactionPatternStats* stats = &patternStats[i];
+        LOG("  %s: %d nodes, %d outputs, %d backtracks, %d masks cleared, %d/%d tries failed, %d us\n", CompoundDatabase::GetPatternName(i),
+            stats->nodesVisited, stats->outputCalls, stats->backtracks, stats->masksCleared, stats->patternsFailed, stats->patternsTried,
+            stats->microseconds);
+    }
+    PeriodicUnlock(lock);
+}
+
+//------------------------------------------------------------------------------
+// Standalone app interface
+//------------------------------------------------------------------------------
+#ifdef STANDALONE_APP
+PeriodicExport uint32 GetReactionSearchCount()
+{
+    return ReactionStats::GetSearchCount();
+}
+
+//! Copies the statistics of the given pattern to statsOut, returns false if there is no such pattern in the current database.
+PeriodicExport bool GetReactionPatternStats(int pattern, ReactionPatternStats* statsOut)
+{
+    if (pattern < 0 || pattern >= CompoundDatabase::GetPatternCount())
+    { return false; }
+
+    PeriodicLock(lock);
+    *statsOut = *ReactionStats::GetPatternStats(pattern);
+    PeriodicUnlock(lock);
+    return true;
+}
+
+//! Returns the name of the given pattern, or NULL if there is no such pattern in the current database.
+PeriodicExport const char* GetReactionPatternName(int pattern)
+{
+    if (pattern < 0 || pattern >= CompoundDatabase::GetPatternCount())
+    { return NULL; }
+
+    return CompoundDatabase::GetPatternName(pattern);
+}
+
+PeriodicExport void ResetReactionStats()
+{
+    ReactionStats::Reset();
+}
+
+PeriodicExport void LogReactionStats()
+{
+    ReactionStats::Log();
+}
+#endif
+#endif
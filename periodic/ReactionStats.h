@@ -0,0 +1,70 @@
+#ifndef __REACTIONSTATS_H__
+#define __REACTIONSTATS_H__
+
+#include "periodic.h"
+
+class Reaction;
+
+//! The number of searches between dumps of the reaction statistics to the log on device. (The standalone app queries them instead.)
+#define REACTION_STATS_LOG_INTERVAL 64
+
+//! Counters describing how much work the reaction search has done for a single pattern of the compound database.
+//! PeriodicAppCore reads these directly, so this must match ReactionPatternStats in ReactionPatternStats.cs.
+struct ReactionPatternStats
+{
+    //! The number of nodes the pattern's interpreter started processing
+    uint32 nodesVisited;
+    //! The number of times a node looked for an output (ReactionNode::GetOutput)
+    uint32 outputCalls;
+    //! The number of times a node had to try another output because one of its children failed
+    uint32 backtracks;
+    //! The number of times a node stopped using the elements it considered for its depth
+    uint32 masksCleared;
+    //! The number of times the pattern was tried from a root element (The search doesn't build a Compound while it tries a pattern.)
+    uint32 patternsTried;
+    //! The number of times the pattern was tried and didn't match
+    uint32 patternsFailed;
+    //! The total time spent processing the pattern in microseconds (While a reaction is counting a pattern, this is the time it started.)
+    uint32 microseconds;
+};
+
+//! Collects statistics about the reaction search in Reaction::Process, so that patterns that make reactions slow can be found.
+//!
+//! Statistics are only collected when REACTION_STATS is defined (see periodic.h), otherwise these functions and ReactionStatsCount compile away.
+//! Statistics are reset whenever the compound database is loaded since pattern numbers refer to the current database.
+//!
+//! Each reaction counts the work for the pattern it is processing in its own counters, which are added to the statistics when it finishes the
+//! pattern. This keeps counting free of shared state when reactions are processed in parallel.
+class ReactionStats
+{
+public:
+#ifdef REACTION_STATS
+    //! Starts counting the work the given reaction does for a pattern
+    static void BeginPattern(Reaction* reaction);
+    //! Adds the work the given reaction did since BeginPattern to the statistics of the given pattern
+    static void EndPattern(Reaction* reaction, int pattern);
+    //! Called after each search of the compound database, logs the statistics every REACTION_STATS_LOG_INTERVAL searches on device.
+    static void EndSearch();
+
+    static void Reset();
+    static ReactionPatternStats* GetPatternStats(int pattern);
+    static uint32 GetSearchCount();
+    //! Logs the statistics of every pattern
+    static void Log();
+#else
+    static void BeginPattern(Reaction* reaction) { }
+    static void EndPattern(Reaction* reaction, int pattern) { }
+    static void EndSearch() { }
+    static void Reset() { }
+    static void Log() { }
+#endif
+};
+
+//! Increments the given ReactionPatternStats counter of the pattern being processed by the given reaction.
+#ifdef REACTION_STATS
+#define ReactionStatsCount(reaction, counter) ((reaction)->patternStats.counter++)
+#else
+#define ReactionStatsCount(reaction, counter) do { } while (0)
+#endif
+
+#endif
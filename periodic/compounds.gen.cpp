@@ -0,0 +1,120 @@
+// compounds.gen.cpp - automatically generated by CompoundGen using compounds.txt, do not edit this file directly!
+
+#include "compounds.gen.h"
+#include "periodic.h"
+#include "CompoundDatabase.h"
+
+// CompoundGen and the game must agree on these values:
+CompilerAssert(ReactionNodeType_ElementSymbolFilter == 0);
+CompilerAssert(ReactionNodeType_ElementSymbol == 1);
+CompilerAssert(ReactionNodeType_ElementGroupFilter == 2);
+CompilerAssert(ReactionNodeType_ElementGroup == 3);
+CompilerAssert(ReactionNodeType_EitherOr == 4);
+CompilerAssert(ReactionNodeType_NoOp == 5);
+CompilerAssert(BondType_None == 0);
+CompilerAssert(BondType_Ionic == 1);
+CompilerAssert(BondType_Covalent == 2);
+CompilerAssert(ALKALI == 0);
+CompilerAssert(ALKALIEARTH == 1);
+CompilerAssert(HALOGEN == 2);
+CompilerAssert(NOBLE == 3);
+CompilerAssert(HYDROGEN == 4);
+CompilerAssert(NONMETAL == 5);
+CompilerAssert(METALOID == 6);
+CompilerAssert(GROUP_COUNT == 7);
+CompilerAssert(REACTION_NODE_NO_GROUP == 0xFF);
+CompilerAssert(MAX_PATTERN_REQUIRED_SYMBOLS == 4);
+
+alignas(4) const unsigned char compounds[COMPOUNDS_SIZE] =
+{
+    0x50, 0x43, 0x44, 0x42, 0x06, 0x03, 0x0D, 0x00, 0x3B, 0x00, 0x18, 0x00, 0xEC, 0x01, 0xC4, 0x03,
+    0xB0, 0x04, 0x00, 0x00, 0x88, 0x05, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x06, 0x03,
+    0x00, 0x00, 0x00, 0x00, 0x08, 0x01, 0x11, 0x00, 0x04, 0x01, 0x01, 0x00, 0x04, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00,
+    0x0F, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x08, 0x00, 0x02, 0x00, 0x21, 0x00, 0x02, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x02, 0x00, 0x32, 0x00, 0x02, 0x00, 0x01, 0x00, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x02, 0x00, 0x42, 0x00, 0x02, 0x00,
+    0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x02, 0x00,
+    0x52, 0x00, 0x02, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x02, 0x00, 0x61, 0x00, 0x02, 0x02, 0x00, 0x00, 0x00, 0x00, 0x03, 0x35, 0x00, 0x00,
+    0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x35, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x12, 0x00, 0x08, 0x00, 0x6F, 0x00, 0x03, 0x00, 0x10, 0x02, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1A, 0x00, 0x0B, 0x00, 0x84, 0x00, 0x03, 0x00,
+    0x10, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x25, 0x00, 0x04, 0x00,
+    0x9A, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x06, 0x00, 0x00, 0x02, 0x02, 0x00, 0x00,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x29, 0x00, 0x04, 0x00, 0xA4, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x08, 0x10, 0x00, 0x00,
+    0x02, 0x02, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x2D, 0x00, 0x07, 0x00, 0xB4, 0x00, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x08, 0x0F, 0x00, 0x03, 0x03, 0x01, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x34, 0x00, 0x07, 0x00, 0xC5, 0x00, 0x07, 0x03,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x08, 0x0F, 0x00, 0x03, 0x03, 0x01, 0x00, 0x04, 0x02, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x08, 0x01, 0x00, 0x00, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xFF, 0x11, 0x00, 0x01, 0x01, 0x02, 0x01, 0x01, 0xFF, 0x08, 0x00, 0x01, 0x02, 0x02, 0x01,
+    0x01, 0xFF, 0x01, 0x00, 0x01, 0x01, 0x02, 0x02, 0x02, 0xFF, 0x08, 0x00, 0x01, 0x01, 0x02, 0x02,
+    0x02, 0xFF, 0x08, 0x01, 0x01, 0x01, 0x02, 0x02, 0x02, 0xFF, 0x08, 0x02, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x04, 0x00, 0x00, 0x03, 0x01, 0x02, 0x01, 0x01, 0x04, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x04, 0x00, 0x00, 0x03, 0x01, 0x02, 0x01, 0x01, 0x02, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x04, 0x00, 0x00, 0x03, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x02, 0x00, 0x00, 0x03, 0x01, 0x02, 0x01, 0x01, 0x02, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x02, 0x00, 0x00, 0x03, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xFF, 0x03, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0xFF, 0x35, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+    0x00, 0xFF, 0x04, 0x00, 0x03, 0x03, 0x02, 0x01, 0x01, 0x02, 0x00, 0x00, 0x03, 0x03, 0x02, 0x01,
+    0x01, 0x02, 0x00, 0x01, 0x05, 0x02, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x03, 0x03, 0x01, 0x00,
+    0x00, 0x02, 0x00, 0x00, 0x03, 0x03, 0x01, 0x00, 0x00, 0x02, 0x00, 0x01, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0x00, 0x04, 0x01, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+    0x00, 0xFF, 0x04, 0x00, 0x03, 0x03, 0x02, 0x01, 0x01, 0x04, 0x00, 0x00, 0x03, 0x03, 0x02, 0x01,
+    0x01, 0x04, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0xFF, 0x0C, 0x00, 0x03, 0x03, 0x02, 0x01,
+    0x01, 0x04, 0x00, 0x00, 0x03, 0x03, 0x02, 0x01, 0x01, 0x04, 0x00, 0x01, 0x05, 0x02, 0x00, 0x00,
+    0x00, 0xFF, 0x00, 0x00, 0x03, 0x03, 0x01, 0x00, 0x00, 0x04, 0x00, 0x00, 0x03, 0x03, 0x01, 0x00,
+    0x00, 0x04, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x01, 0x00, 0x01, 0x01, 0x02, 0x01,
+    0x01, 0xFF, 0x06, 0x00, 0x01, 0x02, 0x02, 0x03, 0x03, 0xFF, 0x06, 0x00, 0x01, 0x03, 0x02, 0x01,
+    0x01, 0xFF, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x08, 0x00, 0x01, 0x01, 0x02, 0x02,
+    0x02, 0xFF, 0x10, 0x00, 0x01, 0x02, 0x02, 0x01, 0x01, 0xFF, 0x10, 0x00, 0x01, 0x03, 0x02, 0x02,
+    0x02, 0xFF, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x0F, 0x00, 0x01, 0x01, 0x02, 0x01,
+    0x01, 0xFF, 0x08, 0x00, 0x01, 0x02, 0x01, 0x00, 0x00, 0xFF, 0x01, 0x00, 0x01, 0x01, 0x02, 0x01,
+    0x01, 0xFF, 0x08, 0x02, 0x01, 0x02, 0x01, 0x00, 0x00, 0xFF, 0x01, 0x02, 0x01, 0x01, 0x02, 0x01,
+    0x01, 0xFF, 0x08, 0x04, 0x01, 0x02, 0x01, 0x00, 0x00, 0xFF, 0x01, 0x04, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xFF, 0x0F, 0x00, 0x01, 0x01, 0x02, 0x02, 0x02, 0xFF, 0x08, 0x00, 0x01, 0x02, 0x01, 0x00,
+    0x00, 0xFF, 0x01, 0x00, 0x01, 0x01, 0x02, 0x01, 0x01, 0xFF, 0x08, 0x02, 0x01, 0x02, 0x01, 0x00,
+    0x00, 0xFF, 0x01, 0x02, 0x01, 0x01, 0x02, 0x01, 0x01, 0xFF, 0x08, 0x00, 0x01, 0x01, 0x02, 0x01,
+    0x01, 0xFF, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x00,
+    0x08, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00,
+    0x20, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+    0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00,
+    0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00,
+    0x00, 0x18, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00,
+    0x00, 0x08, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00,
+    0x00, 0x18, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00,
+    0x50, 0x65, 0x72, 0x63, 0x68, 0x6C, 0x6F, 0x72, 0x69, 0x63, 0x41, 0x63, 0x69, 0x64, 0x00, 0x48,
+    0x79, 0x64, 0x72, 0x6F, 0x67, 0x65, 0x6E, 0x5F, 0x48, 0x79, 0x64, 0x72, 0x6F, 0x67, 0x65, 0x6E,
+    0x00, 0x48, 0x79, 0x64, 0x72, 0x6F, 0x67, 0x65, 0x6E, 0x5F, 0x48, 0x61, 0x6C, 0x6F, 0x67, 0x65,
+    0x6E, 0x00, 0x48, 0x79, 0x64, 0x72, 0x6F, 0x67, 0x65, 0x6E, 0x5F, 0x41, 0x6C, 0x6B, 0x61, 0x6C,
+    0x69, 0x00, 0x48, 0x61, 0x6C, 0x6F, 0x67, 0x65, 0x6E, 0x5F, 0x48, 0x61, 0x6C, 0x6F, 0x67, 0x65,
+    0x6E, 0x00, 0x48, 0x61, 0x6C, 0x6F, 0x67, 0x65, 0x6E, 0x5F, 0x41, 0x6C, 0x6B, 0x61, 0x6C, 0x69,
+    0x00, 0x4C, 0x69, 0x74, 0x68, 0x69, 0x75, 0x6D, 0x49, 0x6F, 0x64, 0x69, 0x6E, 0x65, 0x00, 0x41,
+    0x6C, 0x6B, 0x61, 0x6C, 0x69, 0x45, 0x61, 0x72, 0x74, 0x68, 0x5F, 0x32, 0x48, 0x61, 0x6C, 0x6F,
+    0x67, 0x65, 0x6E, 0x00, 0x41, 0x6C, 0x6B, 0x61, 0x6C, 0x69, 0x45, 0x61, 0x72, 0x74, 0x68, 0x5F,
+    0x32, 0x48, 0x79, 0x64, 0x72, 0x6F, 0x67, 0x65, 0x6E, 0x00, 0x41, 0x63, 0x65, 0x74, 0x79, 0x6C,
+    0x65, 0x6E, 0x65, 0x00, 0x44, 0x69, 0x73, 0x75, 0x6C, 0x66, 0x75, 0x72, 0x44, 0x69, 0x6F, 0x78,
+    0x69, 0x64, 0x65, 0x00, 0x50, 0x68, 0x6F, 0x73, 0x70, 0x68, 0x6F, 0x72, 0x6F, 0x75, 0x73, 0x41,
+    0x63, 0x69, 0x64, 0x31, 0x00, 0x50, 0x68, 0x6F, 0x73, 0x70, 0x68, 0x6F, 0x72, 0x6F, 0x75, 0x73,
+    0x41, 0x63, 0x69, 0x64, 0x32, 0x00, 0x00, 0x00,
+};
+
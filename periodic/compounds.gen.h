@@ -0,0 +1,15 @@
+// compounds.gen.h - automatically generated by CompoundGen using compounds.txt, do not edit this file directly!
+#ifndef __COMPOUNDS_GEN_H__
+#define __COMPOUNDS_GEN_H__
+
+#define COMPOUNDS_VERSION 6
+#define COMPOUNDS_PATTERN_COUNT 13
+#define COMPOUNDS_NODE_COUNT 59
+#define COMPOUNDS_MAX_DEPTH 3
+#define COMPOUNDS_MAX_CHILDREN 4
+
+#define COMPOUNDS_SIZE 1416
+extern const unsigned char compounds[COMPOUNDS_SIZE];
+
+#endif
+
@@ -2,8 +2,10 @@
 #include "assets.gen.h"
 #endif
 #include "coders_crux.gen.h"
+#include "CompoundDatabase.h"
 #include "Element.h"
 #include "ElementCube.h"
+#include "OutcomeTable.h"
 #include "Reaction.h"
 #include "periodic.h" 
 #include "Set.h"
@@ -23,6 +25,8 @@ static Metadata M = Metadata()
 
 //! ElementCube instances used in this program. There should be one for every cube in the simulation.
 ElementCube cubes[NUM_CUBES];
+//! True when the cubes have changed in a way that isn't tracked by their components, so the next neighborhood change must process every cube.
+bool neighborhoodNeedsFullProcess = true;
 
 /*
 Some reactions you can make with this set:
@@ -64,6 +68,9 @@ const char* perchloricAcid[] = { "H", "Cl", "O", "O", "O", "O" };
 
 //! Processes the entire Sifteo Cube neighborhood and handles any reactions present in it
 void ProcessNeighborhood();
+//! Processes only the components of the neighborhood that contain the given cubes (before or after the change that affected them.)
+//! The reactions and cube state of all other components are left alone.
+void ProcessNeighborhoodAround(unsigned firstId, unsigned secondId);
 
 //! Called when a specific cube is pressed (as in, touched after not being touched.)
 void OnPress(unsigned cubeId);
@@ -73,10 +80,11 @@ void OnRelease(unsigned cubeId);
 PeriodicExport void OnTouch(void* sender, unsigned cubeId);
 
 //! Raw Sifteo event handler used to process cubes touching
-void OnNeighborAdd(void* sender, unsigned firstId, unsigned firstSide, unsigned secondId, unsigned secondSide);
+PeriodicExport void OnNeighborAdd(void* sender, unsigned firstId, unsigned firstSide, unsigned secondId, unsigned secondSide);
 //! Raw Sifteo event handler used to process cubes untouching
-void OnNeighborRemove(void* sender, unsigned firstId, unsigned firstSide, unsigned secondId, unsigned secondSide);
-//! Standalone app event handler used to process cube neighborhoods changing
+PeriodicExport void OnNeighborRemove(void* sender, unsigned firstId, unsigned firstSide, unsigned secondId, unsigned secondSide);
+//! Standalone app event handler used to process cube neighborhoods changing, this processes every cube.
+//! Hosts that know which cubes changed should use OnNeighborAdd and OnNeighborRemove instead.
 PeriodicExport void OnNeighborhoodChanged();
 
 void __ApplyCubeSet(const char* symbolSet[], int length)
@@ -85,6 +93,8 @@ void __ApplyCubeSet(const char* symbolSet[], int length)
     {
         cubes[i].Initialize(i, symbolSet[i]);
     }
+
+    neighborhoodNeedsFullProcess = true;
 }
 
 #define ApplyCubeSet(symbolSet) __ApplyCubeSet(symbolSet, CountOfArray(symbolSet));
@@ -100,6 +110,18 @@ PeriodicExport void RequestStop()
 PeriodicExport void main()
 {
     LOG("Enterting main...\n");
+    Element::CheckSymbolHash();
+
+    // Load the compound database, the standalone app prefers a compiled database in its working directory so compounds can be changed without rebuilding.
+    #ifdef STANDALONE_APP
+    if (!CompoundDatabase::LoadFile("compounds.bin"))
+    #endif
+    { CompoundDatabase::LoadDefault(); }
+
+    // The standalone app also answers small reactions from an outcome table generated by OutcomeGen when there is one. (See OutcomeTable.h)
+    #ifdef STANDALONE_APP
+    OutcomeTable::LoadFile("outcomes.bin");
+    #endif
 
     // Initialize ElementCubes:
     // Due to a bug in the Sifteo linker, we can't statically initialize these at all.
@@ -153,6 +175,12 @@ void SetCubeRotation(ElementCube* neighbor, int firstCubeSide, int secondCubeSid
     neighbor->RotateByClockwise((CubeRotation)rotationAmount);
 }
 
+//! The first cube of the component each cube belongs to (the cube its reaction was built from.)
+int cubeComponents[NUM_CUBES];
+//! The active reaction for the component started by each cube, NULL if that component didn't form any compounds.
+Reaction* componentReactions[NUM_CUBES];
+int activeReactionCount = 0;
+
 void AddNeighbors(int forCube, bool* hasBeenUsed)
 {
     Neighborhood nh(forCube);
@@ -181,38 +209,119 @@ void AddNeighbors(int forCube, bool* hasBeenUsed)
         SetCubeRotation(neighbor, i, (int)GetOppositeSideFor(forCube, neighborCube));
 
         hasBeenUsed[neighborCube] = true;
+        cubeComponents[neighborCube] = cubeComponents[forCube];
         AddNeighbors(neighborCube, hasBeenUsed);
     }
 }
 
-Set<Reaction, MAX_REACTIONS> reactions;
-void ProcessNeighborhood()
+//! Marks the given cube as affected along with every cube it was connected to when its component was last processed and every cube it is connected to now.
+void MarkAffected(int cubeId, bool* isAffected)
 {
-    // Reset all of the cubes:
+    if (isAffected[cubeId])
+    { return; }
+
+    isAffected[cubeId] = true;
+
+    // Cubes that were in the same component:
     for (int i = 0; i < NUM_CUBES; i++)
-    { cubes[i].Reset(); }
+    {
+        if (cubeComponents[i] == cubeComponents[cubeId])
+        { MarkAffected(i, isAffected); }
+    }
 
-    // Destroy old reactions
-    for (int i = 0; i < reactions.Count(); i++)
-    { delete reactions[i]; }
-    reactions.Clear();
+    // Cubes that are connected now:
+    Neighborhood nh(cubeId);
+    for (int i = 0; i < NUM_SIDES; i++)
+    {
+        if (nh.hasCubeAt((Side)i))
+        { MarkAffected(nh.cubeAt((Side)i), isAffected); }
+    }
+}
 
+//! Worker callback used to evaluate one of the pending reactions
+static void EvaluateReaction(int index, void* reactions)
+{
+    ((Reaction**)reactions)[index]->Evaluate();
+}
+
+//! Evaluates the given reactions and applies their outcomes, saving the ones that resulted in any compounds as their component's active reaction.
+//! Components never share cubes, so the standalone app evaluates their reactions in parallel. Outcomes are always applied on this thread.
+void ProcessPendingReactions(Reaction** reactions, int* roots, int* count)
+{
+#ifdef STANDALONE_APP
+    Sifteo::__parallel_for(*count, EvaluateReaction, reactions);
+#else
+    for (int i = 0; i < *count; i++)
+    { EvaluateReaction(i, reactions); }
+#endif
+
+    for (int i = 0; i < *count; i++)
+    {
+        if (reactions[i]->Apply())
+        {
+            componentReactions[roots[i]] = reactions[i];
+            activeReactionCount++;
+        }
+        else
+        { delete reactions[i]; }
+    }
+
+    *count = 0;
+}
+
+//! Rebuilds and processes the reactions for the affected cubes.
+//! The affected cubes must be closed over their old and new components. (See MarkAffected.)
+void ProcessAffectedCubes(bool* isAffected)
+{
+    // Reset the affected cubes:
+    for (int i = 0; i < NUM_CUBES; i++)
+    {
+        if (isAffected[i])
+        {
+            cubes[i].Reset();
+            cubeComponents[i] = i;
+        }
+    }
+
+    // Destroy their old reactions
+    for (int i = 0; i < NUM_CUBES; i++)
+    {
+        if (isAffected[i] && componentReactions[i] != NULL)
+        {
+            delete componentReactions[i];
+            componentReactions[i] = NULL;
+            activeReactionCount--;
+        }
+    }
+
+    // Unaffected cubes are treated as used so the reactions never reach into their components.
     bool hasBeenUsed[NUM_CUBES];
-    PeriodicMemset(hasBeenUsed, 0, sizeof(hasBeenUsed));
+    for (int i = 0; i < NUM_CUBES; i++)
+    { hasBeenUsed[i] = !isAffected[i]; }
 
+    // The reactions of the components that have been found but not processed yet, and the cube each component was built from.
+    Reaction* pendingReactions[MAX_REACTIONS];
+    int pendingRoots[MAX_REACTIONS];
+    int pendingCount = 0;
+
+    // Cubes are visited in the same order as a full rebuild so each component is still built from its lowest cube.
     for (int i = 0; i < NUM_CUBES; i++)
     {
         if (hasBeenUsed[i])
         { continue; }
 
-        // Abort if the reaction list's space (and therefore the Reaction ObjectPool) is depleted:
-        if (reactions.Count() >= reactions.Capacity())
+        // Process the pending reactions once they fill up the Reaction ObjectPool, which frees the ones that didn't result in any compounds:
+        if (activeReactionCount + pendingCount >= MAX_REACTIONS)
+        { ProcessPendingReactions(pendingReactions, pendingRoots, &pendingCount); }
+
+        // Abort if the Reaction ObjectPool is depleted:
+        if (activeReactionCount >= MAX_REACTIONS)
         {
             LOG("WARNING: Some cubes are going unprocessed because we've depleted the Reaction ObjectPool!\n");
+            neighborhoodNeedsFullProcess = true; // The unprocessed cubes must be picked up by the next change even if it happens elsewhere.
             break;
         }
 
-        Neighborhood nh(i);
         Reaction* reaction = new Reaction();
 
         // Find the entire reaction:
@@ -220,12 +329,42 @@ void ProcessNeighborhood()
         hasBeenUsed[i] = true;
         AddNeighbors(i, hasBeenUsed);
 
-        // Process the reaction, and save it to our list of active reactions if it resulted in any compounds:
-        if (reaction->Process())
-        { reactions.Add(reaction); }
-        else
-        { delete reaction; }
+        pendingReactions[pendingCount] = reaction;
+        pendingRoots[pendingCount] = i;
+        pendingCount++;
+    }
+
+    ProcessPendingReactions(pendingReactions, pendingRoots, &pendingCount);
+}
+
+void ProcessNeighborhood()
+{
+    bool isAffected[NUM_CUBES];
+    for (int i = 0; i < NUM_CUBES; i++)
+    { isAffected[i] = true; }
+
+    neighborhoodNeedsFullProcess = false;
+    ProcessAffectedCubes(isAffected);
+}
+
+void ProcessNeighborhoodAround(unsigned firstId, unsigned secondId)
+{
+    if (neighborhoodNeedsFullProcess)
+    {
+        ProcessNeighborhood();
+        return;
     }
+
+    bool isAffected[NUM_CUBES];
+    PeriodicMemset(isAffected, 0, sizeof(isAffected));
+
+    // Either cube may be the base station, which isn't part of any reaction.
+    if (firstId < NUM_CUBES)
+    { MarkAffected(firstId, isAffected); }
+    if (secondId < NUM_CUBES)
+    { MarkAffected(secondId, isAffected); }
+
+    ProcessAffectedCubes(isAffected);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -265,7 +404,7 @@ void OnRelease(unsigned cubeId)
     // Move the tapped cube to the next element
     cubes[cubeId].GoToNextElement();
 
-    ProcessNeighborhood();
+    ProcessNeighborhoodAround(cubeId, cubeId);
 }
 
 //! Internal accounting for OnTouch, used to separate presses from releases.
@@ -302,7 +441,7 @@ void OnNeighborAdd(void* sender, unsigned firstId, unsigned firstSide, unsigned
         quickSelectModeIsOn = true;
     }
     
-    ProcessNeighborhood();
+    ProcessNeighborhoodAround(firstId, secondId);
 }
 
 void OnNeighborRemove(void* sender, unsigned firstId, unsigned firstSide, unsigned secondId, unsigned secondSide)
@@ -310,7 +449,7 @@ void OnNeighborRemove(void* sender, unsigned firstId, unsigned firstSide, unsign
     if (firstId == BASE_STATION_ID || secondId == BASE_STATION_ID)
     { quickSelectModeIsOn = false; }
 
-    ProcessNeighborhood();
+    ProcessNeighborhoodAround(firstId, secondId);
 }
 
 void OnNeighborhoodChanged()
@@ -6,7 +6,7 @@
 //------------------------------------------------------------------------
 #define Assert(x) ASSERT(x)
 #define AssertAlways() Assert(false)
-#define CompilerAssert(x) struct compilerAssertType ## __COUNTER__ { int : !!(x); }
+#define CompilerAssert(x) static_assert(x, #x)
 
 #define CountOfArray(a) ( sizeof(a) / sizeof(*a) )
 
@@ -19,6 +19,27 @@
 #define PeriodicMemset(destination, value, count) memset(destination, value, count)
 #endif
 
+//------------------------------------------------------------------------
+// Build options
+//------------------------------------------------------------------------
+// Define REACTION_STATS to collect statistics about the reaction search on device, see ReactionStats.h.
+// The standalone app always collects them since it can query them at any time.
+#if defined(STANDALONE_APP) && !defined(REACTION_STATS)
+#define REACTION_STATS
+#endif
+
+// The standalone app processes independent reactions on worker threads (see ProcessAffectedCubes in main.cpp), so the little engine state that is
+// shared between reactions is protected by locks. Sifteo games are single-threaded, so these compile away on device.
+#ifdef STANDALONE_APP
+#define PeriodicDeclareLock(name) static Sifteo::__lock name
+#define PeriodicLock(lock) (lock).acquire()
+#define PeriodicUnlock(lock) (lock).release()
+#else
+#define PeriodicDeclareLock(name)
+#define PeriodicLock(lock)
+#define PeriodicUnlock(lock)
+#endif
+
 //------------------------------------------------------------------------
 // Constants
 //------------------------------------------------------------------------
@@ -36,11 +57,18 @@
 #define NUM_CUBES 8 // 12 max
 #endif
 // Note: Each cube takes about 1 KB of memory because of the frame buffer. Setting this too high leaves us with no room to allocate stack.
-// Current safe max seems to be 8 cubes
+// Current safe max seems to be 8 cubes. Compounds record their own bonds now (see CompoundBond), which should leave room for more, but the device
+// limit stays at 8 until that has been measured on hardware.
 
 #define MAX_REACTIONS ((NUM_CUBES + 1) / 2 + 1)  // Half of the number of cubes, rounded up, plus an extra for processing cubes with no neighbors
 #define MAX_COMPOUNDS (MAX_REACTIONS * 2)
 
+#ifdef STANDALONE_APP
+#define COMPOUND_POOL_SIZE (MAX_COMPOUNDS * MAX_REACTIONS) // Every reaction may be searching for compounds at the same time (see ProcessAffectedCubes)
+#else
+#define COMPOUND_POOL_SIZE MAX_COMPOUNDS
+#endif
+
 //------------------------------------------------------------------------
 // Types
 //------------------------------------------------------------------------
@@ -48,9 +76,25 @@
 typedef unsigned long size_t; // Sifteo doesn't declare size_t for some reason.
 #endif
 
+typedef unsigned char uint8;
+CompilerAssert(sizeof(uint8) == 1);
+
+typedef unsigned short uint16;
+CompilerAssert(sizeof(uint16) == 2);
+
 typedef unsigned int uint32;
 CompilerAssert(sizeof(uint32) == 4);
 
+//! A set of the elements of a reaction, bit N is set for element N (in reaction order). A reaction never has more elements than there are cubes,
+//! so this is sized from NUM_CUBES. Use ElementMaskBit to build one from an element's index.
+#if NUM_CUBES <= 16
+typedef uint16 ElementMask;
+#else
+typedef uint32 ElementMask;
+#endif
+CompilerAssert(NUM_CUBES <= sizeof(ElementMask) * 8); // More cubes than this would need a wider ElementMask.
+#define ElementMaskBit(element) ((ElementMask)((ElementMask)1 << (element)))
+
 //------------------------------------------------------------------------
 // Generic Utility Functions
 //------------------------------------------------------------------------